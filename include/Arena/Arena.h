@@ -0,0 +1,78 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "GameLogic.h"
+#include "IBot.h"
+
+// Một bên trong trận: "minimax", "mcts" hoặc "pachi" cùng ngân sách thời gian mỗi nước
+struct ArenaBotConfig
+{
+    std::string engine = "mcts";
+    int timeMs = 1000;
+    int depth = 4;            // độ sâu tối đa của MiniMax
+    std::string enginePath;   // đường dẫn engine GTP (pachi), rỗng là mặc định trong assets
+    int maxNodes = 0;         // số nút cây tối đa của MCTS, 0 = tính theo timeMs
+
+    // Dạng "engine[:timeMs[:path]]", vd. "mcts:2000", "minimax:500", "pachi:1000:/usr/bin/pachi".
+    // Với mcts phần thứ ba là số nút tối đa, vd. "mcts:2000:500000"
+    static bool parse(const std::string& spec, ArenaBotConfig& out);
+    std::string name() const;
+};
+
+struct ArenaConfig
+{
+    ArenaBotConfig botA;
+    ArenaBotConfig botB;
+    int games = 10;
+    int boardSize = 9;
+    float komi = 6.5f;
+    int concurrency = 0;      // số ván chạy song song, 0 = số lõi
+    int maxMoves = 0;         // 0 = boardSize^2 * 3
+    uint64_t seed = 1;
+    std::string outputDir = "arena_out";
+};
+
+// Thời gian suy nghĩ của một bên trong ván
+struct MoveTiming
+{
+    int count = 0;
+    double totalMs = 0.0;
+    double maxMs = 0.0;
+
+    void add(double ms);
+    double averageMs() const { return count ? totalMs / count : 0.0; }
+};
+
+struct ArenaGameResult
+{
+    int index = 0;
+    bool aIsBlack = true;     // đổi màu luân phiên giữa các ván
+    std::string result;       // theo SGF: "B+R", "W+3.5", "0"
+    int winner = -1;          // 0 = bot A, 1 = bot B, -1 = hòa
+    int moves = 0;
+    int illegalMoves = 0;     // nước không hợp lệ bị tính là pass
+    double seconds = 0.0;
+    MoveTiming black;
+    MoveTiming white;
+    std::string sgfPath;
+};
+
+// Cho hai bot đánh N ván không cần cửa sổ SFML: chỉ dùng GameLogic và các IBot
+class Arena
+{
+private:
+    ArenaConfig m_config;
+
+    std::shared_ptr<IBot> createBot(const ArenaBotConfig& config, uint64_t seed) const;
+    ArenaGameResult playGame(int index) const;
+
+    std::string toSgf(const ArenaGameResult& result, const std::vector<GameMove>& moves) const;
+
+public:
+    explicit Arena(const ArenaConfig& config);
+
+    // Chạy mọi ván (song song theo concurrency), ghi SGF từng ván và results.csv vào outputDir
+    std::vector<ArenaGameResult> run();
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+// Ván dùng làm dữ liệu cho benchmark: các ván MCTS tự đấu ghi lại bằng target Arena
+// (mcts:300 trên 9x9 và 13x13, mcts:200 trên 19x19). Chuỗi nước đi theo cú pháp SGF, pass là []
+namespace BenchGames
+{
+    // 9x9, 70 moves
+    const char* const GAME_9 =
+        ";B[fd];W[ed];B[ee];W[fe];B[de];W[ff];B[gd];W[ec];B[ge];W[gf];B[hf];W[ce];B[dd];W[dc];B[cd];W[he]"
+        ";B[hd];W[cc];B[bd];W[bc];B[ef];W[eg];B[fg];W[gg];B[gh];W[hg];B[ie];W[fh];B[be];W[dg];B[cf];W[fb]"
+        ";B[hh];W[ig];B[gb];W[fg];B[hc];W[cg];B[bg];W[ac];B[af];W[bh];B[fa];W[ea];B[ch];W[dh];B[fc];W[eb]"
+        ";B[ba];W[ca];B[cb];W[bb];B[da];W[db];B[ei];W[ca];B[fi];W[ci];B[ah];W[ih];B[bi];W[hi];B[gi];W[ai]"
+        ";B[ag];W[di];B[ii];W[bi];B[ae];W[hi]";
+
+    // 13x13, 195 moves
+    const char* const GAME_13 =
+        ";B[fd];W[gc];B[ge];W[kc];B[gg];W[ej];B[fc];W[cf];B[fb];W[kh];B[lj];W[je];B[jd];W[id];B[dg];W[jc]"
+        ";B[jk];W[eh];B[gi];W[gh];B[fh];W[fg];B[hh];W[eg];B[df];W[gf];B[hf];W[ei];B[ff];W[ef];B[ee];W[de]"
+        ";B[dh];W[di];B[ch];W[ci];B[bh];W[bi];B[ce];W[dd];B[bf];W[bg];B[cg];W[ah];B[ag];W[fk];B[kd];W[cd]"
+        ";B[be];W[kf];B[ic];W[ld];B[hd];W[ke];B[ai];W[gk];B[hk];W[hl];B[hj];W[gl];B[il];W[ed];B[fe];W[ib]"
+        ";B[ik];W[aj];B[bj];W[ah];B[dk];W[ai];B[ek];W[fj];B[el];W[af];B[ae];W[bk];B[bl];W[ck];B[cl];W[dm]"
+        ";B[dl];W[al];B[hm];W[gm];B[cj];W[dj];B[bj];W[im];B[hc];W[li];B[kg];W[jg];B[lg];W[kj];B[kk];W[lk]"
+        ";B[jh];W[mj];B[ig];W[jf];B[lh];W[ki];B[ll];W[kl];B[km];W[lm];B[jl];W[jb];B[mi];W[mh];B[mg];W[lf]"
+        ";B[mi];W[ji];B[ih];W[mh];B[em];W[mf];B[cm];W[hi];B[gj];W[ak];B[kl];W[cj];B[ii];W[lg];B[fi];W[hb]"
+        ";B[kd];W[bm];B[am];W[lb];B[ka];W[bm];B[jm];W[ja];B[gb];W[kb];B[am];W[ie];B[if];W[bm];B[lc];W[mc]"
+        ";B[am];W[fm];B[hm];W[mb];B[im];W[me];B[bm];W[mk];B[ij];W[la];B[ad];W[jd];B[ab];W[ec];B[db];W[jj]"
+        ";B[ia];W[eb];B[bb];W[ac];B[bd];W[dc];B[cc];W[cb];B[gd];W[da];B[ga];W[he];B[ml];W[bc];B[fa];W[cc]"
+        ";B[ba];W[ca];B[ea];W[ha];B[db];W[ed];B[da];W[ac];B[eb];W[bc];B[de];W[cb];B[ec];W[ca];B[cc];W[dd]"
+        ";B[dc];W[];B[ca]";
+
+    // 19x19, 170 moves
+    const char* const GAME_19 =
+        ";B[jq];W[dn];B[bm];W[fb];B[dc];W[mh];B[bb];W[ip];B[om];W[ih];B[gi];W[hc];B[hh];W[mn];B[ii];W[fo]"
+        ";B[hg];W[kn];B[mf];W[ep];B[lb];W[hi];B[pg];W[kp];B[ge];W[ji];B[fl];W[ob];B[ld];W[nf];B[dq];W[lq]"
+        ";B[je];W[nb];B[hj];W[hf];B[ll];W[dd];B[bc];W[ig];B[eo];W[do];B[nh];W[lc];B[mc];W[mg];B[if];W[he]"
+        ";B[jh];W[jg];B[hd];W[ec];B[nl];W[gf];B[ed];W[id];B[ng];W[lf];B[ic];W[kg];B[ie];W[jd];B[gd];W[ke]"
+        ";B[kf];W[ff];B[kd];W[jc];B[lg];W[jf];B[je];W[me];B[ie];W[jb];B[em];W[ql];B[mq];W[mp];B[ib];W[ee]"
+        ";B[en];W[dp];B[fd];W[if];B[fp];W[cc];B[cd];W[fq];B[lp];W[ko];B[gp];W[de];B[kq];W[lr];B[db];W[eq]"
+        ";B[pe];W[lo];B[oq];W[gq];B[hr];W[hp];B[je];W[nj];B[go];W[cm];B[mi];W[oo];B[gc];W[od];B[gb];W[ni]"
+        ";B[gn];W[jp];B[np];W[cb];B[lh];W[mf];B[cn];W[no];B[hq];W[dm];B[cq];W[ce];B[cl];W[da];B[iq];W[eb]"
+        ";B[pn];W[bl];B[kr];W[fn];B[gr];W[fm];B[gm];W[po];B[ln];W[dl];B[dc];W[qo];B[er];W[dr];B[fr];W[ml]"
+        ";B[mm];W[lm];B[qn];W[bq];B[ro];W[rn];B[cp];W[co];B[nm];W[rm];B[bo];W[bn];B[an];W[bp];B[cr];W[bd]"
+        ";B[km];W[ao];B[qp];W[rp];B[so];W[sp];B[ln];W[nq];B[mr];W[lm]";
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Gói tài nguyên: mọi file trong resources/ nằm liền nhau trong một file, đọc qua memory map.
+// Bố cục: Header | IndexEntry[count] (sắp theo hash đường dẫn) | bảng đường dẫn | dữ liệu (căn 16 byte).
+// Dữ liệu giữ nguyên PNG/WAV/OGG/TTF, ResourceManager giải mã bằng loadFromMemory
+class AssetArchive
+{
+public:
+    struct Blob
+    {
+        const unsigned char* data = nullptr;
+        size_t size = 0;
+    };
+
+    AssetArchive() = default;
+    ~AssetArchive();
+
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+    size_t getEntryCount() const { return m_entryCount; }
+
+    // Tra theo đường dẫn như trong main.cpp ("resources/images/x.png"); vùng nhớ sống tới khi close()
+    bool find(const std::string& path, Blob& out) const;
+
+    // FNV-1a 64 bit của đường dẫn đã chuẩn hóa ('\' -> '/', bỏ "./" ở đầu)
+    static uint64_t hashPath(const std::string& path);
+    static std::string normalizePath(const std::string& path);
+
+    // Ghi archive từ danh sách file; tên lưu trong archive là đường dẫn đã chuẩn hóa
+    static bool write(const std::string& outPath, const std::vector<std::string>& files, std::string& error);
+
+private:
+    struct IndexEntry
+    {
+        uint64_t hash;
+        uint64_t offset;
+        uint64_t size;
+        uint32_t pathOffset;
+        uint32_t pathLength;
+    };
+
+    IndexEntry entryAt(size_t index) const;
+
+    const unsigned char* m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_entryCount = 0;
+
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
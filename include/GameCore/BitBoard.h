@@ -0,0 +1,213 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Bitboard 512 bit cho bàn tối đa 19x19.
+// Ô (x, y) nằm ở bit y * STRIDE + x; cột x = 19 luôn trống để phép dịch
+// ngang không tràn sang hàng kế bên (được cắt bằng mặt nạ onBoard).
+struct alignas(32) BitBoard
+{
+    static const int WORDS = 8;
+    static const int STRIDE = 20;
+    static const int MAX_SIZE = 19;
+
+    uint64_t w[WORDS];
+
+    BitBoard() { clear(); }
+
+    void clear() { std::memset(w, 0, sizeof(w)); }
+
+    static int index(int x, int y) { return y * STRIDE + x; }
+
+    void set(int idx) { w[idx >> 6] |= (1ULL << (idx & 63)); }
+    void reset(int idx) { w[idx >> 6] &= ~(1ULL << (idx & 63)); }
+    bool test(int idx) const { return (w[idx >> 6] >> (idx & 63)) & 1ULL; }
+
+    static BitBoard single(int idx)
+    {
+        BitBoard b;
+        b.set(idx);
+        return b;
+    }
+
+    // Mặt nạ các ô hợp lệ của bàn size x size
+    static BitBoard onBoardMask(int size)
+    {
+        BitBoard b;
+        for(int y = 0; y < size; ++y)
+        {
+            for(int x = 0; x < size; ++x)
+            {
+                b.set(index(x, y));
+            }
+        }
+        return b;
+    }
+
+    int popcount() const
+    {
+        int count = 0;
+        for(int i = 0; i < WORDS; ++i)
+        {
+            count += __builtin_popcountll(w[i]);
+        }
+        return count;
+    }
+
+    // Chỉ số bit thấp nhất, -1 nếu rỗng
+    int lowestBit() const
+    {
+        for(int i = 0; i < WORDS; ++i)
+        {
+            if(w[i]) return i * 64 + __builtin_ctzll(w[i]);
+        }
+        return -1;
+    }
+
+#if defined(__AVX2__)
+    __m256i lo() const { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w)); }
+    __m256i hi() const { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + 4)); }
+
+    static BitBoard fromLanes(__m256i l, __m256i h)
+    {
+        BitBoard b;
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(b.w), l);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(b.w + 4), h);
+        return b;
+    }
+
+    bool isZero() const
+    {
+        __m256i v = _mm256_or_si256(lo(), hi());
+        return _mm256_testz_si256(v, v);
+    }
+
+    bool operator==(const BitBoard& o) const
+    {
+        __m256i d = _mm256_or_si256(_mm256_xor_si256(lo(), o.lo()), _mm256_xor_si256(hi(), o.hi()));
+        return _mm256_testz_si256(d, d);
+    }
+
+    BitBoard operator|(const BitBoard& o) const { return fromLanes(_mm256_or_si256(lo(), o.lo()), _mm256_or_si256(hi(), o.hi())); }
+    BitBoard operator&(const BitBoard& o) const { return fromLanes(_mm256_and_si256(lo(), o.lo()), _mm256_and_si256(hi(), o.hi())); }
+
+    // this & ~o
+    BitBoard andNot(const BitBoard& o) const { return fromLanes(_mm256_andnot_si256(o.lo(), lo()), _mm256_andnot_si256(o.hi(), hi())); }
+
+    // Dịch về phía bit cao n bit (1 <= n < 64); phần tràn giữa các word được đẩy lên word kế tiếp
+    BitBoard shiftUp(int n) const
+    {
+        __m256i l = lo();
+        __m256i h = hi();
+        __m128i count = _mm_cvtsi32_si128(n);
+        __m128i back = _mm_cvtsi32_si128(64 - n);
+
+        __m256i carryL = _mm256_permute4x64_epi64(_mm256_srl_epi64(l, back), _MM_SHUFFLE(2, 1, 0, 3));
+        __m256i carryH = _mm256_permute4x64_epi64(_mm256_srl_epi64(h, back), _MM_SHUFFLE(2, 1, 0, 3));
+
+        __m256i newL = _mm256_or_si256(_mm256_sll_epi64(l, count), _mm256_blend_epi32(carryL, _mm256_setzero_si256(), 0x03));
+        __m256i newH = _mm256_or_si256(_mm256_sll_epi64(h, count), _mm256_blend_epi32(carryH, carryL, 0x03));
+        return fromLanes(newL, newH);
+    }
+
+    BitBoard shiftDown(int n) const
+    {
+        __m256i l = lo();
+        __m256i h = hi();
+        __m128i count = _mm_cvtsi32_si128(n);
+        __m128i back = _mm_cvtsi32_si128(64 - n);
+
+        __m256i carryL = _mm256_permute4x64_epi64(_mm256_sll_epi64(l, back), _MM_SHUFFLE(0, 3, 2, 1));
+        __m256i carryH = _mm256_permute4x64_epi64(_mm256_sll_epi64(h, back), _MM_SHUFFLE(0, 3, 2, 1));
+
+        __m256i newL = _mm256_or_si256(_mm256_srl_epi64(l, count), _mm256_blend_epi32(carryL, carryH, 0xC0));
+        __m256i newH = _mm256_or_si256(_mm256_srl_epi64(h, count), _mm256_blend_epi32(carryH, _mm256_setzero_si256(), 0xC0));
+        return fromLanes(newL, newH);
+    }
+#else
+    bool isZero() const
+    {
+        uint64_t acc = 0;
+        for(int i = 0; i < WORDS; ++i) acc |= w[i];
+        return acc == 0;
+    }
+
+    bool operator==(const BitBoard& o) const
+    {
+        uint64_t diff = 0;
+        for(int i = 0; i < WORDS; ++i) diff |= (w[i] ^ o.w[i]);
+        return diff == 0;
+    }
+
+    BitBoard operator|(const BitBoard& o) const
+    {
+        BitBoard r;
+        for(int i = 0; i < WORDS; ++i) r.w[i] = w[i] | o.w[i];
+        return r;
+    }
+
+    BitBoard operator&(const BitBoard& o) const
+    {
+        BitBoard r;
+        for(int i = 0; i < WORDS; ++i) r.w[i] = w[i] & o.w[i];
+        return r;
+    }
+
+    BitBoard andNot(const BitBoard& o) const
+    {
+        BitBoard r;
+        for(int i = 0; i < WORDS; ++i) r.w[i] = w[i] & ~o.w[i];
+        return r;
+    }
+
+    BitBoard shiftUp(int n) const
+    {
+        BitBoard r;
+        r.w[0] = w[0] << n;
+        for(int i = 1; i < WORDS; ++i) r.w[i] = (w[i] << n) | (w[i - 1] >> (64 - n));
+        return r;
+    }
+
+    BitBoard shiftDown(int n) const
+    {
+        BitBoard r;
+        for(int i = 0; i < WORDS - 1; ++i) r.w[i] = (w[i] >> n) | (w[i + 1] << (64 - n));
+        r.w[WORDS - 1] = w[WORDS - 1] >> n;
+        return r;
+    }
+#endif
+
+    bool operator!=(const BitBoard& o) const { return !(*this == o); }
+
+    BitBoard& operator|=(const BitBoard& o) { *this = *this | o; return *this; }
+    BitBoard& operator&=(const BitBoard& o) { *this = *this & o; return *this; }
+
+    // Các ô kề cạnh (4 hướng) của tập hiện tại, cắt theo mặt nạ bàn cờ
+    BitBoard neighbors(const BitBoard& onBoard) const
+    {
+        return (shiftUp(1) | shiftDown(1) | shiftUp(STRIDE) | shiftDown(STRIDE)) & onBoard;
+    }
+
+    // Số khí giả: tổng số cặp (quân, ô trống kề) theo cả 4 hướng
+    int pseudoLiberties(const BitBoard& empty) const
+    {
+        return (shiftUp(1) & empty).popcount() + (shiftDown(1) & empty).popcount()
+             + (shiftUp(STRIDE) & empty).popcount() + (shiftDown(STRIDE) & empty).popcount();
+    }
+
+    // Loang từ các quân hạt giống trong tập stones
+    BitBoard floodFill(const BitBoard& stones, const BitBoard& onBoard) const
+    {
+        BitBoard group = *this & stones;
+        for(;;)
+        {
+            BitBoard grown = (group | group.neighbors(onBoard)) & stones;
+            if(grown == group) return group;
+            group = grown;
+        }
+    }
+};
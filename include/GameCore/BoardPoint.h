@@ -0,0 +1,15 @@
+#pragma once
+
+// Tọa độ một giao điểm trên bàn (x: cột, y: hàng). Lõi game dùng kiểu riêng thay cho sf::Vector2i
+// để thư viện gocore không phụ thuộc SFML
+struct BoardPoint
+{
+    int x = 0;
+    int y = 0;
+
+    BoardPoint() {}
+    BoardPoint(int px, int py) : x(px), y(py) {}
+
+    bool operator==(const BoardPoint& other) const { return x == other.x && y == other.y; }
+    bool operator!=(const BoardPoint& other) const { return !(*this == other); }
+};
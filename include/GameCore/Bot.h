@@ -1,32 +1,58 @@
 #pragma once
-#include <windows.h>
 #include <string>
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <memory>
 #include <mutex>
-#include <SFML/System/Vector2.hpp>
+#include <chrono>
+#include <cctype>
+#include "BoardPoint.h"
 #include "IBot.h"
+#include "GtpTransport.h"
+#include "GtpFramer.h"
+#include "Win32Transport.h"
+#include "PosixTransport.h"
+
+// Kết quả của một lệnh trong sendBatch
+struct GtpReply
+{
+    bool success = false;  // '=' thành công, '?' hoặc không có phản hồi là thất bại
+    std::string text;      // nội dung phản hồi, hoặc thông báo lỗi
+};
 
 class Bot
 {
 private:
-    HANDLE hChildStd_IN_Rd = NULL;
-    HANDLE hChildStd_IN_Wr = NULL;
-    HANDLE hChildStd_OUT_Rd = NULL;
-    HANDLE hChildStd_OUT_Wr = NULL;
+    std::unique_ptr<GtpTransport> m_transport;
+    GtpFramer m_framer;
+
+    static constexpr int RESPONSE_TIMEOUT_MS = 20000;
+
+    // Mọi lệnh đều gắn id GTP để ghép phản hồi đúng lệnh; phản hồi trễ của lệnh đã hết giờ bị bỏ qua
+    int m_nextId = 1;
 
     int boardSize = 19;
     const std::string BOARD_COLS = "ABCDEFGHJKLMNOPQRST";
 
     std::mutex m_mutex;
+    std::mutex m_processMutex;   // giữ khi tạo/hủy m_transport, để abort() từ luồng khác không đụng transport đã hủy
 
+    static std::unique_ptr<GtpTransport> createTransport()
+    {
+#ifdef _WIN32
+        return std::unique_ptr<GtpTransport>(new Win32Transport());
+#else
+        return std::unique_ptr<GtpTransport>(new PosixTransport());
+#endif
+    }
+
+    // Phản hồi đã tách khung: "= ..." là thành công, "? ..." là lỗi (trả về chuỗi rỗng)
     std::string cleanResponse(std::string response)
     {
-        size_t equalSign = response.find("=");
-        if(equalSign != std::string::npos)
+        if(!response.empty() && response[0] == '=')
         {
-            std::string clean = response.substr(equalSign + 1);
+            std::string clean = response.substr(1);
             while(!clean.empty() && (clean.back() == '\n' || clean.back() == '\r' || clean.back() == ' ')) clean.pop_back();
             while(!clean.empty() && (clean.front() == ' ' || clean.front() == '\r' || clean.front() == '\n')) clean.erase(0, 1);
             return clean;
@@ -34,36 +60,35 @@ private:
         return "";
     }
 
+    // "=12 nội dung" -> 12, bodyStart trỏ ngay sau id; -1 nếu phản hồi không có id
+    static int responseId(const std::string& response, size_t& bodyStart)
+    {
+        bodyStart = 1;
+        while(bodyStart < response.size() && std::isdigit((unsigned char)response[bodyStart])) bodyStart++;
+        if(bodyStart == 1 || bodyStart - 1 > 9) return -1;
+        return std::stoi(response.substr(1, bodyStart - 1));
+    }
+
 public:
     Bot() { }
     ~Bot() { close(); }
 
-    bool peekPipe(DWORD* bytesAvail)
-    {
-        if(hChildStd_OUT_Rd == NULL) return false;
-        return PeekNamedPipe(hChildStd_OUT_Rd, NULL, 0, NULL, bytesAvail, NULL);
-    }
-
-    bool readPipe(char* buffer, int size, DWORD* bytesRead)
+    // Đọc output của engine, chờ tối đa timeoutMs. Trả về số byte, 0 nếu chưa có gì, -1 nếu engine đã đóng
+    int readOutput(char* buffer, int size, int timeoutMs)
     {
-        if(hChildStd_OUT_Rd == NULL) return false;
-        return ReadFile(hChildStd_OUT_Rd, buffer, size, bytesRead, NULL);
+        if(!m_transport) return -1;
+        return m_transport->read(buffer, size, timeoutMs);
     }
 
     void flushPipe()
     {
         char chBuf[4096];
-        DWORD dwRead, dwAvail;
         int safety = 50;
         while(safety-- > 0)
         {
-            if(!peekPipe(&dwAvail)) break;
-            if(dwAvail > 0)
-            {
-                ReadFile(hChildStd_OUT_Rd, chBuf, sizeof(chBuf), &dwRead, NULL);
-            }
-            else break;
+            if(readOutput(chBuf, sizeof(chBuf), 0) <= 0) break;
         }
+        m_framer.clear();
     }
 
     void setBoardSize(int size)
@@ -71,137 +96,140 @@ public:
         this->boardSize = size;
     }
 
-    bool start(std::string exePath, int size = 19)
+    bool start(std::string exePath, int size = 19, const std::vector<std::string>& args = {})
     {
         this->boardSize = size;
-        SECURITY_ATTRIBUTES saAttr;
-        saAttr.nLength = sizeof(SECURITY_ATTRIBUTES);
-        saAttr.bInheritHandle = TRUE;
-        saAttr.lpSecurityDescriptor = NULL;
-
-        if(!CreatePipe(&hChildStd_OUT_Rd, &hChildStd_OUT_Wr, &saAttr, 0)) return false;
-        if(!SetHandleInformation(hChildStd_OUT_Rd, HANDLE_FLAG_INHERIT, 0)) return false;
-
-        if(!CreatePipe(&hChildStd_IN_Rd, &hChildStd_IN_Wr, &saAttr, 0)) return false;
-        if(!SetHandleInformation(hChildStd_IN_Wr, HANDLE_FLAG_INHERIT, 0)) return false;
-
-        HANDLE hNullFile = CreateFileA("NUL", GENERIC_WRITE, FILE_SHARE_WRITE,
-                                       &saAttr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
-
-        STARTUPINFOA si;
-        PROCESS_INFORMATION pi;
-        ZeroMemory(&si, sizeof(si));
-        si.cb = sizeof(si);
 
-        si.hStdInput = hChildStd_IN_Rd;
-        si.hStdOutput = hChildStd_OUT_Wr;
-        si.hStdError = hNullFile;
+        close();
+        m_framer.clear();
 
-        si.dwFlags |= STARTF_USESTDHANDLES | STARTF_USESHOWWINDOW;
-        si.wShowWindow = SW_HIDE;
-
-        ZeroMemory(&pi, sizeof(pi));
-
-        std::string cmdLine = "\"" + exePath + "\"";
-
-        if(!CreateProcessA(NULL, (LPSTR)cmdLine.c_str(), NULL, NULL, TRUE, 0, NULL, NULL, &si, &pi))
+        std::lock_guard<std::mutex> lock(m_processMutex);
+        m_transport = createTransport();
+        if(!m_transport->start(exePath, args))
         {
-            CloseHandle(hNullFile);
+            m_transport.reset();
             return false;
         }
-
-        CloseHandle(pi.hProcess);
-        CloseHandle(pi.hThread);
-        CloseHandle(hChildStd_OUT_Wr);
-        CloseHandle(hChildStd_IN_Rd);
-        CloseHandle(hNullFile);
-
         return true;
     }
 
+    // Kill engine ngay, kể cả khi một sendCommand khác đang chờ phản hồi (lệnh đó trả về lỗi).
+    // Phải start() lại trước khi gửi lệnh tiếp
+    void abort()
+    {
+        std::lock_guard<std::mutex> lock(m_processMutex);
+        if(m_transport) m_transport->terminate();
+    }
+
     std::string sendCommand(std::string cmd)
     {
         std::lock_guard<std::mutex> lock(m_mutex);
 
-        DWORD dwWritten;
-        std::string fullCmd = cmd + "\n";
+        int id = m_nextId++;
+        std::string fullCmd = std::to_string(id) + " " + cmd + "\n";
 
 //        std::cout << "[GTP >>] " << cmd << " (Sending...)" << "\n";
 
-        if(!WriteFile(hChildStd_IN_Wr, fullCmd.c_str(), (DWORD)fullCmd.length(), &dwWritten, NULL))
+        if(!m_transport || !m_transport->write(fullCmd))
         {
-            std::cerr << "[Bot Error] WriteFile failed. Pipe broken?\n";
+            std::cerr << "[Bot Error] Write failed. Pipe broken?\n";
             return "";
         }
 
-        std::string response = "";
+        // Chờ theo sự kiện (poll / overlapped I/O) tới khi đủ một phản hồi, tối đa ~20s
+        std::string response;
         char chBuf[4096];
-        DWORD dwRead, dwAvail;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(RESPONSE_TIMEOUT_MS);
 
-        int maxRetries = 2000;
-        while(maxRetries > 0)
+        for(;;)
         {
-            if(hChildStd_OUT_Rd == NULL) break;
-
-            if(!PeekNamedPipe(hChildStd_OUT_Rd, NULL, 0, NULL, &dwAvail, NULL))
+            while(m_framer.next(response))
             {
-                break;
-            }
+                size_t bodyStart = 0;
+                if(responseId(response, bodyStart) != id) continue;
 
-            if(dwAvail > 0)
-            {
-                if(ReadFile(hChildStd_OUT_Rd, chBuf, sizeof(chBuf) - 1, &dwRead, NULL) && dwRead > 0)
-                {
-                    chBuf[dwRead] = '\0';
-                    response += chBuf;
-
-                    size_t eqPos = response.find('=');
-                    if(eqPos != std::string::npos)
-                    {
-                        size_t nlAfterEq = response.find('\n', eqPos);
-                        if(nlAfterEq != std::string::npos)
-                        {
-                            break;
-                        }
-                    }
-                    else
-                    {
-                    }
-                }
+//                std::cout << "[GTP <<] Raw response:\n" << response << "\n";
+
+                return response[0] == '=' ? cleanResponse("=" + response.substr(bodyStart)) : "";
             }
-            else
+
+            int remaining = (int)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+            if(remaining <= 0)
             {
-                Sleep(10);
-                maxRetries--;
+//                std::cout << "[GTP <<] TIMEOUT! (No response in ~20s)\n";
+                return "";
             }
+
+            int bytesRead = m_transport->read(chBuf, sizeof(chBuf), remaining);
+            if(bytesRead < 0) return "";
+            m_framer.feed(chBuf, bytesRead);
+        }
+    }
+
+    // Gửi liền một lượt tất cả lệnh (mỗi lệnh gắn id GTP) rồi mới thu đủ N phản hồi.
+    // Kết quả theo đúng thứ tự cmds; lệnh lỗi hoặc không có phản hồi có success = false
+    std::vector<GtpReply> sendBatch(const std::vector<std::string>& cmds)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        std::vector<GtpReply> replies(cmds.size());
+        if(cmds.empty()) return replies;
+
+        int firstId = m_nextId;
+        m_nextId += (int)cmds.size();
+
+        std::string payload;
+        for(size_t i = 0; i < cmds.size(); ++i)
+        {
+            payload += std::to_string(firstId + (int)i) + " " + cmds[i] + "\n";
+            replies[i].text = "No response";
         }
 
-        if(maxRetries == 0)
+        if(!m_transport || !m_transport->write(payload))
         {
-//            std::cout << "[GTP <<] TIMEOUT! (No response in ~20s)\n";
-            if(!response.empty())
-            {
-//                std::cout << "[GTP <<] Partial response (raw):\n" << response << "\n";
-            }
+            std::cerr << "[Bot Error] Write failed. Pipe broken?\n";
+            for(auto& r : replies) r.text = "Write failed";
+            return replies;
         }
-        else
+
+        std::string response;
+        char chBuf[4096];
+        size_t received = 0;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(RESPONSE_TIMEOUT_MS);
+
+        while(received < cmds.size())
         {
-//            std::cout << "[GTP <<] Raw response:\n" << response << "\n";
+            if(m_framer.next(response))
+            {
+                // "=12 nội dung" hoặc "?12 lỗi"; phản hồi không có id hoặc của lệnh trước bị bỏ qua
+                size_t pos = 0;
+                int index = responseId(response, pos) - firstId;
+                if(index < 0 || index >= (int)cmds.size()) continue;
+
+                replies[index].success = (response[0] == '=');
+                replies[index].text = cleanResponse("=" + response.substr(pos));
+                received++;
+                continue;
+            }
+
+            int remaining = (int)std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+            if(remaining <= 0) break;
+
+            int bytesRead = m_transport->read(chBuf, sizeof(chBuf), remaining);
+            if(bytesRead < 0) break;
+            m_framer.feed(chBuf, bytesRead);
         }
 
-        return cleanResponse(response);
+        return replies;
     }
 
     void close()
     {
-        if(hChildStd_IN_Wr)
+        std::lock_guard<std::mutex> lock(m_processMutex);
+        if(m_transport)
         {
-            DWORD dwWritten;
-            std::string s = "quit\n";
-            WriteFile(hChildStd_IN_Wr, s.c_str(), (DWORD)s.length(), &dwWritten, NULL);
-            CloseHandle(hChildStd_IN_Wr);
-            CloseHandle(hChildStd_OUT_Rd);
-            hChildStd_IN_Wr = NULL;
+            m_transport->close();
+            m_transport.reset();
         }
     }
 
@@ -213,7 +241,7 @@ public:
         return colChar + std::to_string(gtpRow);
     }
 
-    sf::Vector2i fromGTP(std::string gtp)
+    BoardPoint fromGTP(std::string gtp)
     {
         if(gtp.length() < 2) return {-1, -1};
         std::string lower = gtp;
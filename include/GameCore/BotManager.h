@@ -4,9 +4,20 @@
 #include <atomic>
 #include "IBot.h"
 #include "PachiBot.h"
+#include "EnginePool.h"
 #include "MiniMaxBot.h"
+#include "MCTSBot.h"
 #include "GlobalSetting.h"
 
+// Engine cho startBot; Default giữ cách chọn theo độ khó (Easy: MiniMax, còn lại: Pachi)
+enum class BotEngine
+{
+    Default,
+    MiniMax,
+    MCTS,
+    Pachi
+};
+
 class BotManager
 {
 public:
@@ -16,73 +27,86 @@ public:
         return instance;
     }
 
-    void startBackgroundPachi(int boardSize)
+    // Khởi động sẵn một tiến trình Pachi trong pool (gọi lúc mở ứng dụng)
+    void warmUpEngines(int boardSize)
     {
-        if(m_backgroundPachi)
-        {
-            m_backgroundPachi->sendCommand("clear_board");
-            m_backgroundPachi->setBoardSize(boardSize);
-            m_backgroundPachi->sendCommand("boardsize " + std::to_string(boardSize));
-            m_backgroundPachi->sendCommand("time_settings 0 1 1");
-            return;
-        }
-
-        m_backgroundPachi = std::make_shared<PachiBot>(boardSize, 3);
-
-        std::thread t([this]()
-        {
-            if(m_backgroundPachi)
-            {
-                m_backgroundPachi->init();
-                m_backgroundPachi->sendCommand("time_settings 0 1 1");
-            }
-        });
-        t.detach();
+        m_enginePool.warmUp(boardSize, m_pondering);
     }
 
-    void startBot(AiDifficulty difficulty, int boardSize)
+    void startBot(AiDifficulty difficulty, int boardSize, BotEngine engine = BotEngine::Default)
     {
         m_isReady = false;
         m_currentBot.reset();
+        releaseOpponent();
 
-        if(difficulty == AiDifficulty::Hard || difficulty == AiDifficulty::Medium)
+        if(engine == BotEngine::Default)
         {
-            if(!m_backgroundPachi)
-            {
-                startBackgroundPachi(boardSize);
-            }
+            engine = (difficulty == AiDifficulty::Easy) ? BotEngine::MiniMax : BotEngine::Pachi;
+        }
 
-            m_currentBot = m_backgroundPachi;
+        if(engine == BotEngine::Pachi)
+        {
+            // Đối thủ giữ riêng một engine của pool trong cả ván, gợi ý và đếm quân chết dùng engine khác.
+            // Chỉ engine này pondering
+            m_opponentLease = m_enginePool.checkout(m_pondering);
 
-            if (m_backgroundPachi)
+            if (difficulty == AiDifficulty::Hard)
+            {
+                m_opponentLease->setTimeSettings(0, 8, 1);
+            }
+            else
             {
-                if (difficulty == AiDifficulty::Hard)
-                {
-                    m_backgroundPachi->sendCommand("time_settings 0 8 1");
-                }
-                else
-                {
-                    m_backgroundPachi->sendCommand("time_settings 0 4 1");
-                }
+                m_opponentLease->setTimeSettings(0, 4, 1);
             }
 
+            m_currentBot = m_opponentLease.bot();
             m_isReady = true;
+            return;
+        }
+
+        if(engine == BotEngine::MCTS)
+        {
+            // Thời gian mỗi nước theo độ khó, tương ứng time_settings của Pachi
+            int timeLimitMs = 1000;
+            if(difficulty == AiDifficulty::Medium) timeLimitMs = 4000;
+            else if(difficulty == AiDifficulty::Hard) timeLimitMs = 8000;
+
+            auto mcts = std::make_shared<MCTSBot>(boardSize, timeLimitMs);
+            mcts->setKomi(GlobalSetting::getInstance().getKomiValue());
+            mcts->setPondering(m_pondering && difficulty != AiDifficulty::Easy);
+            m_currentBot = mcts;
         }
         else
         {
-            int depth = 1;
-            m_currentBot = std::make_shared<MiniMaxBot>(boardSize, depth);
+            // Iterative deepening tới maxDepth trong 1 giây mỗi nước, giống "time_settings 0 1 1" của Pachi
+            int maxDepth = 4;
+            auto miniMax = std::make_shared<MiniMaxBot>(boardSize, maxDepth);
+            miniMax->setTimeLimit(1000);
 
-            std::thread t([this]()
-            {
-                if(m_currentBot)
-                {
-                    m_currentBot->init();
-                    m_isReady = true;
-                }
-            });
-            t.detach();
+            // Chia nhánh gốc cho các lõi rảnh; máy ít lõi thì tìm tuần tự (alpha-beta ở gốc hiệu quả hơn)
+            unsigned int cores = std::thread::hardware_concurrency();
+            miniMax->setThreadCount(cores >= 4 ? (int)cores : 1);
+            m_currentBot = miniMax;
         }
+
+        std::thread t([this]()
+        {
+            if(m_currentBot)
+            {
+                m_currentBot->init();
+                m_isReady = true;
+            }
+        });
+        t.detach();
+    }
+
+    // Bỏ bot đối thủ khi rời ván hoặc vào ván hai người: engine đối thủ trả về pool
+    // (engine pondering bị tắt) để không chiếm CPU và chỗ trong pool
+    void stopBot()
+    {
+        m_isReady = false;
+        m_currentBot.reset();
+        releaseOpponent();
     }
 
     std::shared_ptr<IBot> getBot()
@@ -90,9 +114,10 @@ public:
         return m_currentBot;
     }
 
-    std::shared_ptr<PachiBot> getBackgroundBot()
+    // Các engine Pachi dùng chung cho gợi ý, đếm quân chết và đối thủ
+    EnginePool& getEnginePool()
     {
-        return m_backgroundPachi;
+        return m_enginePool;
     }
 
     bool isReady() const
@@ -100,10 +125,25 @@ public:
         return m_isReady;
     }
 
+    // Cho bot đối thủ nghĩ tiếp trong lượt người chơi. Áp dụng từ lần startBot sau
+    void setPondering(bool enabled)
+    {
+        m_pondering = enabled;
+    }
+
 private:
     BotManager() {}
 
+    void releaseOpponent()
+    {
+        // Lượt genmove đã hủy của ván trước có thể còn chạy trên engine đối thủ cũ
+        if(m_opponentLease) m_opponentLease->waitIdle();
+        m_opponentLease.release();
+    }
+
     std::shared_ptr<IBot> m_currentBot;
-    std::shared_ptr<PachiBot> m_backgroundPachi;
+    EnginePool m_enginePool;
+    EnginePool::Lease m_opponentLease;
     std::atomic<bool> m_isReady{false};
+    bool m_pondering = true;
 };
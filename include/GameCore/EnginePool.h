@@ -0,0 +1,253 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <iostream>
+#include "PachiBot.h"
+
+// Nhóm tiến trình Pachi cho gợi ý, đếm quân chết và đối thủ, mỗi tác vụ mượn một tiến trình riêng
+// nên có thể chạy song song. Pool giữ vị trí ván hiện tại; mỗi PachiBot nhớ các nước nó đã nhận
+// và được đồng bộ lại lúc được mượn ra (PachiBot::syncPosition)
+class EnginePool
+{
+private:
+    struct Slot
+    {
+        std::shared_ptr<PachiBot> bot;
+        bool started = false;
+        bool inUse = false;
+        bool pondering = false;   // engine khởi động với tùy chọn pondering (chỉ dành cho đối thủ)
+    };
+
+    std::mutex m_mutex;
+    std::condition_variable m_released;
+    std::vector<std::unique_ptr<Slot>> m_slots;
+
+    int m_poolSize = defaultPoolSize();
+
+    int m_boardSize = 19;
+    std::vector<GameMove> m_position;
+
+    std::thread m_warmUpThread;
+
+    static int defaultPoolSize()
+    {
+        // Một tiến trình cho đối thủ, phần còn lại cho gợi ý / đếm quân chết
+        unsigned int cores = std::thread::hardware_concurrency();
+        return cores >= 4 ? 3 : 2;
+    }
+
+    // Gọi khi đang giữ m_mutex. Ưu tiên engine đã khởi động, đúng chế độ pondering,
+    // cần ít lệnh nhất để tới vị trí hiện tại. Engine chưa khởi động hoặc sai chế độ còn phải nạp lại Pachi:
+    // dùng slot trống chưa khởi động, rồi tạo slot mới khi pool chưa đủ; chỉ khởi động lại engine
+    // sai chế độ khi pool đã đầy
+    Slot* pickFreeSlot(bool pondering)
+    {
+        Slot* best = nullptr;
+        size_t bestCost = 0;
+        Slot* unstarted = nullptr;
+        Slot* wrongMode = nullptr;
+        for(auto& s : m_slots)
+        {
+            if(s->inUse) continue;
+
+            if(!s->started)
+            {
+                if(!unstarted) unstarted = s.get();
+                continue;
+            }
+            if(s->pondering != pondering)
+            {
+                if(!wrongMode) wrongMode = s.get();
+                continue;
+            }
+
+            size_t cost = s->bot->syncCost(m_boardSize, m_position);
+            if(!best || cost < bestCost)
+            {
+                bestCost = cost;
+                best = s.get();
+            }
+        }
+
+        if(best) return best;
+        if(unstarted) return unstarted;
+
+        if((int)m_slots.size() < m_poolSize)
+        {
+            m_slots.push_back(std::unique_ptr<Slot>(new Slot()));
+            return m_slots.back().get();
+        }
+        return wrongMode;
+    }
+
+    // Chạy trên luồng của người mượn: slot đang inUse nên chỉ luồng này đụng vào engine
+    void prepareSlot(Slot* slot, int boardSize, const std::vector<GameMove>& target, bool pondering)
+    {
+        // Pondering là tham số dòng lệnh của Pachi: đổi chế độ thì khởi động lại tiến trình
+        if(slot->started && slot->pondering != pondering)
+        {
+            slot->bot.reset();
+            slot->started = false;
+        }
+
+        if(!slot->started)
+        {
+            slot->bot = std::make_shared<PachiBot>(boardSize, 3);
+            slot->bot->setPondering(pondering);
+            slot->bot->init();
+            slot->bot->setTimeSettings(0, 1, 1);
+            slot->pondering = pondering;
+            slot->started = true;
+        }
+
+        slot->bot->syncPosition(boardSize, target);
+    }
+
+    void checkin(Slot* slot)
+    {
+        // Engine pondering vẫn nghĩ tiếp sau lượt cuối khi không còn ai cần nước của nó: tắt đi,
+        // lần mượn sau khởi động lại
+        bool stopEngine = slot->pondering && slot->bot && slot->bot->mayBePondering();
+        if(stopEngine) slot->bot->shutdown();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(stopEngine) slot->started = false;
+            slot->inUse = false;
+        }
+        m_released.notify_one();
+    }
+
+public:
+    EnginePool() {}
+
+    // Chờ engine đang khởi động sẵn trước khi hủy các slot
+    ~EnginePool()
+    {
+        if(m_warmUpThread.joinable()) m_warmUpThread.join();
+    }
+
+    EnginePool(const EnginePool&) = delete;
+    EnginePool& operator=(const EnginePool&) = delete;
+
+    // Quyền dùng riêng một engine; tự trả về pool khi hủy. Engine tự theo dõi các nước nó nhận
+    // (syncMove, generateMove, undoMove) nên người mượn có thể để lại bàn ở vị trí khác
+    class Lease
+    {
+    private:
+        EnginePool* m_pool = nullptr;
+        Slot* m_slot = nullptr;
+
+        friend class EnginePool;
+        Lease(EnginePool* pool, Slot* slot) : m_pool(pool), m_slot(slot) {}
+
+    public:
+        Lease() {}
+        ~Lease() { release(); }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        Lease(Lease&& other) noexcept
+            : m_pool(other.m_pool), m_slot(other.m_slot)
+        {
+            other.m_pool = nullptr;
+            other.m_slot = nullptr;
+        }
+
+        Lease& operator=(Lease&& other) noexcept
+        {
+            if(this != &other)
+            {
+                release();
+                m_pool = other.m_pool;
+                m_slot = other.m_slot;
+                other.m_pool = nullptr;
+                other.m_slot = nullptr;
+            }
+            return *this;
+        }
+
+        explicit operator bool() const { return m_slot != nullptr; }
+        PachiBot* operator->() const { return m_slot->bot.get(); }
+        std::shared_ptr<PachiBot> bot() const { return m_slot ? m_slot->bot : nullptr; }
+
+        void release()
+        {
+            if(m_pool && m_slot) m_pool->checkin(m_slot);
+            m_pool = nullptr;
+            m_slot = nullptr;
+        }
+    };
+
+    // Chờ tới khi có engine rảnh (khởi động thêm nếu pool chưa đủ), đồng bộ nó với vị trí hiện tại.
+    // Engine gợi ý / đếm quân chết không pondering: sau genmove nó sẽ nghĩ tiếp và chiếm CPU vô ích.
+    // Chỉ lease của đối thủ xin pondering = true
+    Lease checkout(bool pondering = false)
+    {
+        Slot* slot = nullptr;
+        int boardSize;
+        std::vector<GameMove> target;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_released.wait(lock, [&]() { return (slot = pickFreeSlot(pondering)) != nullptr; });
+            slot->inUse = true;
+            boardSize = m_boardSize;
+            target = m_position;
+        }
+
+        prepareSlot(slot, boardSize, target, pondering);
+        return Lease(this, slot);
+    }
+
+    // Khởi động trước một engine ở luồng nền để lần mượn đầu không phải chờ Pachi nạp.
+    // pondering theo người mượn đầu tiên dự kiến (đối thủ)
+    void warmUp(int boardSize, bool pondering)
+    {
+        setPosition(boardSize, {});
+        if(m_warmUpThread.joinable()) m_warmUpThread.join();
+        m_warmUpThread = std::thread([this, pondering]()
+        {
+            Lease lease = checkout(pondering);
+        });
+    }
+
+    void setPosition(int boardSize, const std::vector<GameMove>& moves)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_boardSize = boardSize;
+        m_position = moves;
+    }
+
+    void pushMove(bool isBlack, int x, int y)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_position.push_back({isBlack, x, y});
+    }
+
+    void popMove()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if(!m_position.empty()) m_position.pop_back();
+    }
+
+    // Số tiến trình tối đa; không tắt các engine đang chạy khi giảm
+    void setPoolSize(int size)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_poolSize = size < 1 ? 1 : size;
+        }
+        m_released.notify_all();
+    }
+
+    int getPoolSize()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_poolSize;
+    }
+};
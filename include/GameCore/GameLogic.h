@@ -4,7 +4,9 @@
 #include <vector>
 #include <string>
 #include <stack>
-#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <unordered_map>
+#include "BoardPoint.h"
 #include "SaveDefinition.h"
 
 enum class StoneType
@@ -30,24 +32,34 @@ struct MoveResult
     bool gameEnded;
 };
 
-struct GameStateSnapshot
+// Một mục trong nhật ký nước đi: chỉ lưu phần thay đổi để undo/redo tại chỗ
+struct MoveRecord
 {
-    std::vector<std::vector<StoneType>> board;
-    bool isBlacksTurn;
-    std::pair<int, int> koPosition;
+    int index;                      // ô (mảng phẳng) của quân vừa đặt, -1 nếu pass
+    bool isBlack;                   // bên đi nước này
+    std::vector<int> captured;      // các ô bị bắt bởi nước này
+    std::pair<int, int> koPosition; // trạng thái trước nước đi
     bool lastPlayerPassed;
 };
 
+// Một nước trong lịch sử ván, dùng để đồng bộ engine ngoài; x < 0 là pass
+struct GameMove
+{
+    bool isBlack;
+    int x;
+    int y;
+};
+
 struct TerritoryRegion
 {
     TerritoryOwner owner;
-    std::vector<sf::Vector2i> points;
-    std::vector<sf::Vector2i> boundaries;
+    std::vector<BoardPoint> points;
+    std::vector<BoardPoint> boundaries;
 };
 
 struct DeadStoneInfo
 {
-    sf::Vector2i pos;
+    BoardPoint pos;
     TerritoryOwner owner;
 };
 
@@ -92,36 +104,91 @@ public:
     bool saveToFile(const std::string& filePath, const SaveInfo& info, float timeBlack, float timeWhite, int difficulty) const;
     bool loadFromFile(const std::string& filePath, float& timeBlack, float& timeWhite, std::string& modeStr, int& difficulty, std::string& endReason);
 
-    std::vector<TerritoryRegion> getTerritoryRegions(const std::vector<sf::Vector2i>& deadStones) const;
+    std::vector<TerritoryRegion> getTerritoryRegions(const std::vector<BoardPoint>& deadStones) const;
 
-    const std::vector<std::vector<StoneType>>& getBoard() const { return m_board; }
+    // Adapter cho UI: dựng lại bảng 2D từ mảng phẳng (trả về bản sao)
+    std::vector<std::vector<StoneType>> getBoard() const;
 
     ScoreData calculateScore(const std::vector<DeadStoneInfo>& deadStones, float komi);
 
     StoneCount getStoneCount() const;
 
+    // Quân có sẵn khi nạp ván (theo thứ tự quét) rồi các nước đã đi, theo thứ tự
+    std::vector<GameMove> getMoveHistory() const;
+
+    // Zobrist hash của vị trí quân trên bàn (không tính lượt đi), cập nhật dần theo nước đi
+    uint64_t getHash() const { return m_hash; }
+
+    // Positional superko: cấm mọi nước lặp lại một vị trí đã xuất hiện trong ván
+    void setSuperkoEnabled(bool enabled) { m_superko = enabled; }
+    bool isSuperkoEnabled() const { return m_superko; }
+
 private:
+    // Giá trị ô trong mảng phẳng: 0..2 trùng với StoneType, 3 là viền
+    static constexpr uint8_t CELL_EMPTY = 0;
+    static constexpr uint8_t CELL_BLACK = 1;
+    static constexpr uint8_t CELL_WHITE = 2;
+    static constexpr uint8_t CELL_BORDER = 3;
+
     int m_boardSize;
+    int m_stride; // m_boardSize + 2 (có viền sentinel)
+
+    // Bàn cờ phẳng (m_boardSize + 2)^2 ô, mỗi ô 1 byte, viền là CELL_BORDER
+    std::vector<uint8_t> m_board;
+    int m_neighborOffset[4];
+
+    // Chuỗi đá cập nhật dần theo từng nước: danh sách vòng qua m_nextStone,
+    // kích thước và số khí giả (pseudo-liberty) lưu tại ô gốc của chuỗi
+    std::vector<int> m_groupHead;
+    std::vector<int> m_nextStone;
+    std::vector<int> m_groupSize;
+    std::vector<int> m_groupLibs;
+
+    mutable std::vector<int> m_libMark;
+    mutable int m_libMarkStamp;
+
+    // Khóa Zobrist theo ô: [idx * 2 + (màu - 1)]
+    std::vector<uint64_t> m_zobrist;
+    uint64_t m_hash;
+
+    bool m_superko = false;
+    // Số lần mỗi vị trí xuất hiện trên đường đi hiện tại (ứng với undo stack)
+    std::unordered_map<uint64_t, int> m_seenPositions;
 
-    std::vector<std::vector<StoneType>> m_board;
-    std::vector<std::vector<StoneType>> m_previousBoard;
     bool m_isBlacksTurn;
     std::pair<int, int> m_koPosition;
     bool m_lastPlayerPassed;
 
-    std::stack<GameStateSnapshot> m_undoStack;
-    std::stack<GameStateSnapshot> m_redoStack;
+    std::vector<MoveRecord> m_undoStack;
+    std::stack<MoveRecord> m_redoStack;
+
+    // Quân trên bàn lúc nạp ván, vì file lưu chỉ có ảnh bàn cờ chứ không có lịch sử nước đi
+    std::vector<GameMove> m_setupStones;
+
+    MoveRecord createRecord(int idx) const;
+    void applyMove(int idx, uint8_t player, std::vector<int>& captured);
+    void applyPass();
+    void revertMove(const MoveRecord& record);
+
+    void resizeBoard(int size);
+
+    uint64_t zobristKey(int idx, uint8_t player) const { return m_zobrist[idx * 2 + (player - 1)]; }
+    uint64_t hashAfterMove(int idx, uint8_t player) const;
+    void resetPositionHistory();
 
-    GameStateSnapshot createSnapshot() const;
-    void restoreState(const GameStateSnapshot& state);
+    int toIndex(int x, int y) const { return (y + 1) * m_stride + (x + 1); }
+    int indexX(int idx) const { return idx % m_stride - 1; }
+    int indexY(int idx) const { return idx / m_stride - 1; }
 
-    int findGroupLiberties(int x, int y, StoneType player,
-                           std::vector<std::vector<bool>>& visited_stones,
-                           std::vector<std::pair<int, int>>& group,
-                           std::vector<std::vector<bool>>& visited_liberties);
+    void rebuildGroups();
+    void repairGroups(const std::vector<int>& points);
+    void buildGroup(int idx);
+    void placeStone(int idx, uint8_t player);
+    int mergeGroups(int headA, int headB);
+    int countLiberties(int head) const;
 
-    void removeGroup(const std::vector<std::pair<int, int>>& group);
+    void removeGroup(int head, std::vector<int>& removed);
     bool isKo(int x, int y);
-    bool isSuicide(int x, int y, StoneType player);
-    std::vector<std::pair<int, int>> checkAndRemoveCaptures(int x, int y, StoneType player);
+    bool isSuicide(int idx, uint8_t player) const;
+    void checkAndRemoveCaptures(int idx, uint8_t player, std::vector<int>& captured);
 };
@@ -21,6 +21,7 @@ enum class GameStateType
     Quit,
     GoBack,
 
+    Loading,
     MainMenu,
     NewGame,
     SizeSelect,
@@ -0,0 +1,54 @@
+#pragma once
+#include <string>
+
+// Tách luồng byte stdout của engine thành từng phản hồi GTP.
+// Theo đặc tả, phản hồi bắt đầu bằng '=' hoặc '?' và kết thúc bằng một dòng trống;
+// '\r' bị bỏ qua, các dòng rác trước phản hồi (log của engine) bị loại.
+class GtpFramer
+{
+private:
+    std::string m_buffer;
+
+public:
+    void feed(const char* data, int size)
+    {
+        for(int i = 0; i < size; ++i)
+        {
+            if(data[i] != '\r') m_buffer += data[i];
+        }
+    }
+
+    // Lấy phản hồi hoàn chỉnh kế tiếp (không gồm dòng trống cuối). false nếu chưa đủ dữ liệu
+    bool next(std::string& response)
+    {
+        for(;;)
+        {
+            size_t end = m_buffer.find("\n\n");
+            if(end == std::string::npos) return false;
+
+            std::string frame = m_buffer.substr(0, end);
+            m_buffer.erase(0, end + 2);
+
+            // Bỏ các dòng đứng trước ký tự mở đầu phản hồi
+            size_t lineStart = 0;
+            while(lineStart < frame.size() && frame[lineStart] != '=' && frame[lineStart] != '?')
+            {
+                size_t nl = frame.find('\n', lineStart);
+                if(nl == std::string::npos)
+                {
+                    lineStart = frame.size();
+                    break;
+                }
+                lineStart = nl + 1;
+            }
+
+            if(lineStart < frame.size())
+            {
+                response = frame.substr(lineStart);
+                return true;
+            }
+        }
+    }
+
+    void clear() { m_buffer.clear(); }
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Kênh stdin/stdout tới một tiến trình engine GTP.
+// Bot chỉ làm việc qua giao diện này nên cùng một sendCommand chạy được trên Windows lẫn POSIX.
+class GtpTransport
+{
+public:
+    virtual ~GtpTransport() {}
+
+    // Khởi chạy exePath với các tham số args; stderr của engine bị bỏ đi
+    virtual bool start(const std::string& exePath, const std::vector<std::string>& args) = 0;
+
+    virtual bool write(const std::string& data) = 0;
+
+    // Chờ tối đa timeoutMs rồi đọc tối đa size byte.
+    // Trả về số byte đọc được, 0 nếu hết giờ, -1 nếu pipe đã đóng hoặc lỗi
+    virtual int read(char* buffer, int size, int timeoutMs) = 0;
+
+    virtual bool isOpen() const = 0;
+
+    // Kill tiến trình ngay, không chờ "quit". Gọi được từ luồng khác khi read() đang chờ (read() trả -1);
+    // close() vẫn phải được gọi sau đó để đóng pipe
+    virtual void terminate() = 0;
+
+    virtual void close() = 0;
+};
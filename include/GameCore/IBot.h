@@ -1,7 +1,13 @@
 #pragma once
 #include <string>
 #include <vector>
-#include <SFML/System/Vector2.hpp>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <functional>
+#include "BoardPoint.h"
 
 struct BotMove
 {
@@ -11,8 +17,33 @@ struct BotMove
     bool isResign = false;
 };
 
-class IBot
+class IBot : public std::enable_shared_from_this<IBot>
 {
+private:
+    // Một lượt tìm nước bất đồng bộ; luồng nền và luồng UI cùng giữ shared_ptr tới nó
+    struct AsyncMoveState
+    {
+        std::atomic<bool> done{false};
+        std::atomic<bool> cancelled{false};
+        BotMove move;
+        std::function<void(const BotMove&)> onComplete;
+    };
+
+    std::mutex m_asyncMutex;
+    std::shared_ptr<AsyncMoveState> m_current; // lượt UI đang chờ (chưa poll, chưa hủy)
+    std::shared_ptr<AsyncMoveState> m_running; // lượt đang chạy generateMove
+
+    std::timed_mutex m_searchMutex;            // mỗi bot chỉ chạy một generateMove tại một thời điểm
+    std::atomic<bool> m_stopRequested{false};
+
+protected:
+    // Bot kiểm tra cờ này trong vòng tìm kiếm để dừng sớm khi lượt hiện tại bị hủy
+    bool isStopRequested() const { return m_stopRequested.load(std::memory_order_relaxed); }
+
+    // Gọi từ luồng hủy (cancelMove) khi lượt đang chạy bị hủy, cờ isStopRequested đã được bật.
+    // Bot ghi đè để ngắt engine ngoài tiến trình; phải an toàn khi gọi song song với generateMove
+    virtual void interruptSearch() {}
+
 public:
     virtual ~IBot() {}
 
@@ -22,7 +53,100 @@ public:
 
     virtual BotMove generateMove(bool isBlackTurn) = 0;
 
-    virtual std::vector<sf::Vector2i> getDeadStones() = 0;
+    virtual std::vector<BoardPoint> getDeadStones() = 0;
 
     virtual void setBoardSize(int size) = 0;
+
+    // Chạy generateMove ở luồng nền. Bot phải được quản lý bằng shared_ptr.
+    // onComplete (nếu có) được gọi trên luồng nền khi xong, không gọi nếu đã hủy
+    void startMove(bool isBlackTurn, std::function<void(const BotMove&)> onComplete = nullptr)
+    {
+        auto state = std::make_shared<AsyncMoveState>();
+        state->onComplete = std::move(onComplete);
+        {
+            std::lock_guard<std::mutex> lock(m_asyncMutex);
+            if(m_current) m_current->cancelled = true;
+            m_current = state;
+        }
+
+        std::shared_ptr<IBot> self = shared_from_this();
+        std::thread([self, state, isBlackTurn]()
+        {
+            std::lock_guard<std::timed_mutex> searchLock(self->m_searchMutex);
+            {
+                std::lock_guard<std::mutex> lock(self->m_asyncMutex);
+                if(state->cancelled) return;
+                self->m_stopRequested = false;
+                self->m_running = state;
+            }
+
+            BotMove move = self->generateMove(isBlackTurn);
+
+            {
+                std::lock_guard<std::mutex> lock(self->m_asyncMutex);
+                self->m_running.reset();
+                self->m_stopRequested = false;
+                state->move = move;
+                state->done = true;
+            }
+
+            if(!state->cancelled && state->onComplete) state->onComplete(move);
+        }).detach();
+    }
+
+    // Lấy kết quả của lượt startMove hiện tại; true đúng một lần khi đã xong
+    bool pollMove(BotMove& move)
+    {
+        std::lock_guard<std::mutex> lock(m_asyncMutex);
+        if(!m_current || !m_current->done) return false;
+
+        move = m_current->move;
+        m_current.reset();
+        return true;
+    }
+
+    bool isThinking()
+    {
+        std::lock_guard<std::mutex> lock(m_asyncMutex);
+        return m_current != nullptr;
+    }
+
+    // Hủy lượt hiện tại: kết quả bị bỏ, tìm kiếm đang chạy được yêu cầu dừng. Không chặn luồng gọi.
+    // Trả true nếu lượt đã xong nhưng chưa được poll: nước đó có thể đã nằm trên bàn của engine
+    bool cancelMove()
+    {
+        bool interrupt = false;
+        bool droppedResult = false;
+        {
+            std::lock_guard<std::mutex> lock(m_asyncMutex);
+            if(!m_current) return false;
+
+            droppedResult = m_current->done;
+
+            m_current->cancelled = true;
+            if(m_running == m_current)
+            {
+                m_stopRequested = true;
+                interrupt = true;
+            }
+            m_current.reset();
+        }
+
+        if(interrupt) interruptSearch();
+        return droppedResult;
+    }
+
+    // Chờ tới khi không còn generateMove nào (kể cả lượt đã hủy) chạy trên bot này
+    void waitIdle()
+    {
+        std::lock_guard<std::timed_mutex> lock(m_searchMutex);
+    }
+
+    // Như waitIdle nhưng chờ tối đa timeoutMs; false nếu lượt tìm kiếm vẫn đang chạy
+    bool waitIdleFor(int timeoutMs)
+    {
+        if(!m_searchMutex.try_lock_for(std::chrono::milliseconds(timeoutMs))) return false;
+        m_searchMutex.unlock();
+        return true;
+    }
 };
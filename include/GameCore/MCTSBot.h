@@ -0,0 +1,152 @@
+#pragma once
+#include "IBot.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <chrono>
+#include <thread>
+#include <atomic>
+
+// Bàn cờ gọn cho playout: mảng cố định có viền, chuỗi đá cập nhật dần,
+// danh sách ô trống để bốc nước ngẫu nhiên. Sao chép bằng memcpy, không dùng heap.
+struct PlayoutBoard
+{
+    static const int MAX_SIZE = 19;
+    static const int MAX_STRIDE = MAX_SIZE + 2;
+    static const int CELLS = MAX_STRIDE * MAX_STRIDE;
+    static const int PASS = -1;
+
+    static const uint8_t EMPTY = 0;
+    static const uint8_t BLACK = 1;
+    static const uint8_t WHITE = 2;
+    static const uint8_t BORDER = 3;
+
+    int size;
+    int stride;
+    int offsets[4];
+    int diagonals[4];
+
+    uint8_t cell[CELLS];
+    int16_t head[CELLS];
+    int16_t next[CELLS];
+    int16_t stones[CELLS];
+    int16_t libs[CELLS];       // khí giả, lưu tại ô gốc của chuỗi
+
+    int16_t emptyList[CELLS];
+    int16_t emptyPos[CELLS];
+    int emptyCount;
+
+    int koPoint;
+    int passes;
+    int moveCount;
+    uint8_t toMove;
+
+    void reset(int boardSize);
+
+    int toIndex(int x, int y) const { return (y + 1) * stride + (x + 1); }
+    int indexX(int idx) const { return idx % stride - 1; }
+    int indexY(int idx) const { return idx / stride - 1; }
+
+    static uint8_t opponent(uint8_t color) { return color == BLACK ? WHITE : BLACK; }
+
+    bool isLegal(int idx, uint8_t color) const;
+    bool isEye(int idx, uint8_t color) const;
+    void play(int idx, uint8_t color);
+
+    // Chủ sở hữu ô cuối ván (quân hoặc mắt một màu), EMPTY nếu trung lập
+    uint8_t owner(int idx) const;
+    float score(float komi) const; // Đen - Trắng - komi, tính theo diện tích
+
+private:
+    bool isSuicide(int idx, uint8_t color) const;
+    void addEmpty(int idx);
+    void removeEmpty(int idx);
+    void mergeGroups(int a, int b);
+    void removeGroup(int h);
+};
+
+// Bot Monte Carlo tree search (UCT + RAVE) với playout ngẫu nhiên nhẹ, chạy ngay trong tiến trình
+class MCTSBot : public IBot
+{
+private:
+    struct Node
+    {
+        int move;          // ô trên PlayoutBoard hoặc PASS
+        int firstChild;    // -1 khi chưa mở rộng
+        int childCount;
+        float visits;
+        float wins;        // thắng của bên vừa đi nước move
+        float raveVisits;
+        float raveWins;
+    };
+
+    static const int MAX_GAME_LENGTH = PlayoutBoard::CELLS * 3;
+
+    int m_boardSize;
+    float m_komi = 6.5f;
+    int m_timeLimitMs;
+    int m_maxPlayouts;
+
+    PlayoutBoard m_board;       // vị trí hiện tại đã đồng bộ
+    PlayoutBoard m_scratch;     // bàn dùng cho từng playout
+
+    std::vector<Node> m_nodes;  // cấp phát một lần; gốc cây luôn ở chỉ số 0
+    std::vector<Node> m_spare;  // vùng đích khi nén cây con lúc đổi gốc
+    int m_nodeCount = 0;
+
+    // Cây còn khớp với m_board và bên đi m_rootColor thì nước sau được tìm tiếp trên cây cũ
+    bool m_treeValid = false;
+    uint8_t m_lastGenerated = PlayoutBoard::EMPTY; // màu nước vừa sinh, chờ syncMove để bắt đầu ponder
+
+    // Suy nghĩ trong lượt đối phương
+    bool m_pondering = false;
+    std::thread m_ponderThread;
+    std::atomic<bool> m_ponderStop{false};
+
+    // Bộ đệm cố định cho một lượt mô phỏng
+    int m_path[MAX_GAME_LENGTH + 1];
+    int m_sequence[MAX_GAME_LENGTH];
+    uint8_t m_firstColor[PlayoutBoard::CELLS];
+
+    uint8_t m_rootColor = PlayoutBoard::BLACK;
+    uint64_t m_rng;
+
+    uint32_t nextRandom()
+    {
+        m_rng ^= m_rng << 13;
+        m_rng ^= m_rng >> 7;
+        m_rng ^= m_rng << 17;
+        return (uint32_t)(m_rng >> 32);
+    }
+
+    int newNode(int move);
+    void expand(int nodeIdx, const PlayoutBoard& board);
+    int selectChild(int nodeIdx);
+    int runPlayout(PlayoutBoard& board, int& length);
+    void simulate();
+
+    void resetTree(uint8_t color);
+    void advanceTree(int move);
+    bool canStopEarly(int playouts, float elapsedMs, float remainingMs) const;
+    void startPonder();
+    void stopPonder();
+
+public:
+    MCTSBot(int size, int timeLimitMs = 3000, int maxNodes = 1 << 20);
+    ~MCTSBot();
+
+    void init() override;
+    void setBoardSize(int size) override;
+    void syncMove(std::string color, int x, int y) override;
+    BotMove generateMove(bool isBlackTurn) override;
+    std::vector<BoardPoint> getDeadStones() override;
+
+    void setKomi(float komi) { m_komi = komi; }
+    void setTimeLimit(int milliseconds) { m_timeLimitMs = milliseconds; }
+    // Giới hạn số playout mỗi nước (0 = chỉ theo thời gian)
+    void setMaxPlayouts(int playouts) { m_maxPlayouts = playouts; }
+    void setSeed(uint64_t seed) { m_rng = seed ? seed : 0x9E3779B97F4A7C15ULL; }
+
+    // Bật thì sau khi nước của bot được đồng bộ, bot tiếp tục tìm kiếm cho tới nước kế tiếp của đối phương
+    void setPondering(bool enabled);
+};
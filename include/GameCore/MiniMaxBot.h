@@ -1,10 +1,15 @@
 #pragma once
 #include "IBot.h"
+#include "BitBoard.h"
+#include "TranspositionTable.h"
+#include "ThreadPool.h"
 #include <vector>
+#include <memory>
 #include <limits>
 #include <algorithm>
 #include <ctime>
 #include <cstdlib>
+#include <chrono>
 
 enum class MMStone { Empty, Black, White };
 
@@ -12,44 +17,111 @@ class MiniMaxBot : public IBot
 {
 private:
     int m_boardSize;
-    int m_depth;
-    std::vector<std::vector<MMStone>> m_board;
+    int m_depth;          // độ sâu tối đa
+    int m_timeLimitMs = 0; // 0 = không giới hạn, tìm đúng m_depth
 
-    const int DX[4] = {0, 0, 1, -1};
-    const int DY[4] = {1, -1, 0, 0};
+    // Điều khiển thời gian cho iterative deepening
+    std::chrono::steady_clock::time_point m_deadline;
+    bool m_stopSearch = false;
+    unsigned int m_nodes = 0;
+
+    // Bot giữ cờ hủy của startMove; bot phụ trỏ về bot chính
+    const MiniMaxBot* m_stopSource = this;
+
+    // Bàn cờ dạng bitboard (tối đa 19x19), mỗi màu một mặt phẳng bit
+    BitBoard m_black;
+    BitBoard m_white;
+    BitBoard m_onBoard;
+
+    // Một mục của stack make/unmake: đủ để hoàn tác chính xác một nước
+    struct UndoEntry
+    {
+        int index;
+        MMStone color;
+        BitBoard captured;
+    };
+
+    // Danh sách nước ứng viên cấp phát trên stack, không dùng heap trong lúc tìm kiếm
+    struct MoveList
+    {
+        int count = 0;
+        int moves[BitBoard::MAX_SIZE * BitBoard::MAX_SIZE];
+
+        void push(int idx) { moves[count++] = idx; }
+    };
+
+    std::vector<UndoEntry> m_undoStack;
+
+    // Zobrist hash của bàn cờ nội bộ, cập nhật trong playStone/unmakeMove
+    uint64_t m_hash = 0;
+    std::shared_ptr<TranspositionTable> m_tt;
+
+    // Tìm kiếm song song ở gốc: mỗi luồng một bản sao bàn cờ, dùng chung bảng chuyển vị
+    int m_threads = 1;
+    std::unique_ptr<ThreadPool> m_pool;
+    std::vector<std::unique_ptr<MiniMaxBot>> m_helpers;
+
+    // Chỉ dùng mục TT cùng độ sâu, để giá trị không phụ thuộc thứ tự chạy giữa các luồng
+    bool m_exactDepthProbe = false;
+
+    // Bot phụ cho một luồng tìm kiếm, dùng chung bảng của bot chính
+    explicit MiniMaxBot(const std::shared_ptr<TranspositionTable>& sharedTable)
+        : m_boardSize(BitBoard::MAX_SIZE), m_depth(1), m_tt(sharedTable), m_exactDepthProbe(true)
+    {
+        m_undoStack.reserve(64);
+    }
 
 public:
-    MiniMaxBot(int size, int depth) : m_boardSize(size), m_depth(depth)
+    MiniMaxBot(int size, int depth, int hashSizeMB = 16)
+        : m_boardSize(size), m_depth(depth), m_tt(std::make_shared<TranspositionTable>(hashSizeMB))
     {
         std::srand(static_cast<unsigned int>(std::time(nullptr)));
+        m_undoStack.reserve(64);
         setBoardSize(size);
     }
 
     void init() override
     {
-        for(auto& row : m_board)
-        {
-            std::fill(row.begin(), row.end(), MMStone::Empty);
-        }
+        m_black.clear();
+        m_white.clear();
+        m_undoStack.clear();
+        m_hash = 0;
+        m_tt->clear();
     }
 
     void setBoardSize(int size) override
     {
         m_boardSize = size;
-        m_board.assign(size, std::vector<MMStone>(size, MMStone::Empty));
+        m_onBoard = BitBoard::onBoardMask(size);
+        init();
     }
 
     void syncMove(std::string color, int x, int y) override
     {
-        if(x >= 0 && x < m_boardSize && y >= 0 && y < m_boardSize)
+        if(isValid(x, y))
         {
-            m_board[y][x] = (color == "black" ? MMStone::Black : MMStone::White);
+            playStone(BitBoard::index(x, y), color == "black" ? MMStone::Black : MMStone::White);
         }
     }
 
     BotMove generateMove(bool isBlackTurn) override;
 
-    std::vector<sf::Vector2i> getDeadStones() override
+    // Ngân sách thời gian mỗi nước: tăng dần độ sâu 1..m_depth, hết giờ trả về nước tốt nhất đã có
+    void setTimeLimit(int milliseconds) { m_timeLimitMs = milliseconds; }
+
+    // Kích thước bảng chuyển vị (MB); xóa toàn bộ nội dung cũ
+    void setHashSizeMB(int sizeMB) { m_tt->resize(sizeMB); }
+
+    // Số luồng tìm kiếm; 1 = tuần tự. Với seed cố định và không giới hạn thời gian
+    // kết quả không phụ thuộc số luồng hay thứ tự chạy
+    void setThreadCount(int threads)
+    {
+        m_threads = std::max(1, threads);
+        m_pool.reset();
+        m_helpers.clear();
+    }
+
+    std::vector<BoardPoint> getDeadStones() override
     {
         return {};
     }
@@ -57,13 +129,23 @@ public:
 private:
     int evaluate(MMStone myColor);
     int minimax(int depth, bool isMaximizing, MMStone myColor, int alpha, int beta);
-    std::vector<sf::Vector2i> getCandidateMoves(MMStone myColor); // [SỬA] Nhận màu để check luật
-    int simulateMove(int x, int y, MMStone color, std::vector<std::vector<MMStone>>& backupBoard);
+    int searchRoot(int depth, MMStone myColor, MoveList& candidates);
+    int searchRootParallel(int depth, MMStone myColor, MoveList& candidates);
+    int pickRootMove(const MoveList& candidates, const int* values, const bool* done);
+    void getCandidateMoves(MMStone myColor, MoveList& moves); // [SỬA] Nhận màu để check luật
 
-    int countLiberties(int x, int y, MMStone color, std::vector<std::vector<bool>>& visited);
+    // Đặt quân tại chỗ và ghi lại quân bị bắt; unmakeMove hoàn tác nước gần nhất
+    int makeMove(int idx, MMStone color);
+    void unmakeMove();
+    BitBoard playStone(int idx, MMStone color);
+
+    uint64_t nodeKey(MMStone toMove, MMStone myColor) const;
 
     bool isLegalMove(int x, int y, MMStone myColor);
 
+    BitBoard& stonesOf(MMStone color) { return color == MMStone::Black ? m_black : m_white; }
+    BitBoard emptyPoints() const { return m_onBoard.andNot(m_black | m_white); }
+
     bool isValid(int x, int y) const
     {
         return x >= 0 && x < m_boardSize && y >= 0 && y < m_boardSize;
@@ -1,8 +1,12 @@
 #pragma once
 #include "IBot.h"
 #include "Bot.h"
+#include "GameLogic.h"
 #include <string>
 #include <sstream>
+#include <algorithm>
+#include <mutex>
+#include <atomic>
 
 class PachiBot : public IBot
 {
@@ -11,59 +15,88 @@ private:
     int boardSize;
     int difficultyLevel; // 1=Easy, 2=Medium, 3=Hard
 
-public:
-    PachiBot(int size, int difficulty) : boardSize(size), difficultyLevel(difficulty)
-    { }
+#ifdef _WIN32
+    std::string enginePath = "assets/pachi/pachi.exe";
+#else
+    std::string enginePath = "assets/pachi/pachi";
+#endif
+    std::vector<std::string> engineArgs;
+    bool pondering = false;
 
-    std::string sendCommand(std::string cmd)
+    // Các nước engine đã nhận, theo thứ tự, để đồng bộ lại chỉ bằng undo + phần khác nhau.
+    // stateKnown = false khi không chắc bàn của engine còn khớp (vd. một lệnh play bị từ chối).
+    // stateMutex giữ suốt mỗi thao tác đổi bàn để lệnh GTP và seenMoves đổi cùng nhau
+    std::vector<GameMove> seenMoves;
+    int seenBoardSize = 0;
+    bool stateKnown = false;
+    mutable std::mutex stateMutex;
+
+    // Lượt genmove bị hủy thì engine bị kill (interruptSearch) thay vì chờ hết thời gian nghĩ;
+    // thao tác kế tiếp khởi động lại engine và dựng lại bàn từ seenMoves
+    std::atomic<bool> engineKilled{false};
+    std::string timeSettings;   // lệnh time_settings đang dùng, gửi lại sau khi khởi động lại
+    bool searched = false;      // đã genmove từ lúc khởi động: engine pondering có thể đang nghĩ nền
+
+    // Lệnh GTP có id để biết thành công hay lỗi (sendCommand trả chuỗi rỗng cho cả hai)
+    bool runCommand(const std::string& cmd)
     {
-        return pachiEngine.sendCommand(cmd);
+        std::vector<GtpReply> replies = pachiEngine.sendBatch({cmd});
+        return !replies.empty() && replies[0].success;
     }
 
-    std::string toGTP(int x, int y)
+    static bool sameMove(const GameMove& a, const GameMove& b)
     {
-        return pachiEngine.toGTP(x, y);
+        return a.isBlack == b.isBlack && a.x == b.x && a.y == b.y;
     }
 
-    void setBoardSize(int size) override
+    size_t commonPrefix(const std::vector<GameMove>& moves) const
     {
-        this->boardSize = size;
-        pachiEngine.setBoardSize(size);
+        size_t n = std::min(seenMoves.size(), moves.size());
+        size_t i = 0;
+        while(i < n && sameMove(seenMoves[i], moves[i])) i++;
+        return i;
     }
 
-    void init() override
+    // Chạy engine và chờ log khởi động lắng xuống
+    bool startEngine()
     {
-        std::string pachiPath = "assets/pachi/pachi.exe";
-        if (!pachiEngine.start(pachiPath, boardSize))
+        searched = false;
+
+        // Pachi nhận mọi tham số engine trong một chuỗi "a=1,b,c" (tham số không bắt đầu bằng '-')
+        std::vector<std::string> args = engineArgs;
+        if (pondering)
+        {
+            auto it = std::find_if(args.rbegin(), args.rend(), [](const std::string& a) { return !a.empty() && a[0] != '-'; });
+            if (it != args.rend()) *it += ",pondering";
+            else args.push_back("pondering");
+        }
+
+        if (!pachiEngine.start(enginePath, boardSize, args))
         {
             std::cerr << "[PachiBot] ERROR: Failed to start exe.\n";
-            return;
+            return false;
         }
 
         std::cout << "[PachiBot] Engine started. Waiting for startup logs...\n";
 
         char buffer[4096];
-        DWORD read, avail;
         int quietCount = 0;
 
         for (int i = 0; i < 200; ++i)
         {
-            if (!pachiEngine.peekPipe(&avail)) break;
+            int read = pachiEngine.readOutput(buffer, sizeof(buffer) - 1, 100);
+            if (read < 0) break;
 
-            if (avail > 0)
+            if (read > 0)
             {
-                if (pachiEngine.readPipe(buffer, sizeof(buffer) - 1, &read))
-                {
-                    buffer[read] = '\0';
-                    std::string log(buffer);
-                    std::cout << "[Engine Output] " << log;
-                    quietCount = 0;
-                }
+                buffer[read] = '\0';
+                std::string log(buffer);
+                std::cout << "[Engine Output] " << log;
+                quietCount = 0;
             }
             else
             {
                 quietCount++;
-                Sleep(100);
             }
 
             if (quietCount >= 15)
@@ -72,32 +105,66 @@ public:
                 break;
             }
         }
-
-        std::cout << "[PachiBot] Init Finished Successfully.\n";
-
-        std::string test = pachiEngine.sendCommand("name");
-        std::cout << "BOT NAME = " << test << "\n";
+        return true;
     }
 
-    void syncMove(std::string color, int x, int y)
+    // Các hàm *Locked chạy khi đã giữ stateMutex
+
+    // Engine bị kill khi hủy lượt: khởi động lại rồi đưa bàn về đúng các nước đã gửi trước đó
+    void restartIfKilledLocked()
     {
-        std::string coord = pachiEngine.toGTP(x, y);
-        std::string cmd = "play " + color + " " + coord;
+        if(!engineKilled) return;
+        engineKilled = false;
 
-        std::string response = sendCommand(cmd);
+        std::cout << "[PachiBot] Restarting engine after cancelled search.\n";
+        std::vector<GameMove> moves = seenMoves;
+        int size = seenBoardSize > 0 ? seenBoardSize : boardSize;
+        stateKnown = false;
+        seenMoves.clear();
+        if(!startEngine()) return;
 
-//        std::cout << "[PachiBot] Sync: " << cmd << " -> Done." << std::endl;
+        if(!timeSettings.empty()) pachiEngine.sendCommand(timeSettings);
+        syncPositionLocked(size, moves);
     }
 
-    BotMove generateMove(bool isBlackTurn) override
+    void undoLocked()
+    {
+        if(runCommand("undo") && !seenMoves.empty()) seenMoves.pop_back();
+        else stateKnown = false;
+    }
+
+    BotMove generateLocked(bool isBlackTurn, bool& placed)
     {
         std::string turnColor = isBlackTurn ? "black" : "white";
         std::string response = pachiEngine.sendCommand("genmove " + turnColor);
 
+        searched = true;
+
+        // Engine bị kill giữa chừng: không có nước nào được đặt, thao tác kế tiếp sẽ dựng lại engine
+        if(engineKilled)
+        {
+            placed = false;
+            BotMove move;
+            move.isPass = true;
+            move.x = -1;
+            move.y = -1;
+            return move;
+        }
+
+        // genmove đã đặt quân lên bàn của engine; lượt bị hủy thì gỡ lại để engine khớp với ván
+        placed = !response.empty() && response != "resign";
+        if(placed && isStopRequested())
+        {
+            pachiEngine.sendCommand("undo");
+            placed = false;
+        }
+
         BotMove move;
         if(response == "pass")
         {
             move.isPass = true;
+            move.x = -1;
+            move.y = -1;
         }
         else if(response == "resign")
         {
@@ -105,18 +172,239 @@ public:
         }
         else
         {
-            sf::Vector2i p = pachiEngine.fromGTP(response);
+            BoardPoint p = pachiEngine.fromGTP(response);
             move.x = p.x;
             move.y = p.y;
         }
+
+        if(placed) seenMoves.push_back({isBlackTurn, move.x, move.y});
         return move;
     }
 
+    void syncPositionLocked(int size, const std::vector<GameMove>& moves)
+    {
+        if(stateKnown && seenBoardSize == size)
+        {
+            size_t prefix = commonPrefix(moves);
+            size_t undos = seenMoves.size() - prefix;
+            size_t plays = moves.size() - prefix;
+
+            if(undos + plays < moves.size() + 2)
+            {
+                std::vector<std::string> cmds(undos, "undo");
+                for(size_t i = prefix; i < moves.size(); ++i)
+                {
+                    const GameMove& m = moves[i];
+                    cmds.push_back(std::string("play ") + (m.isBlack ? "black " : "white ") + pachiEngine.toGTP(m.x, m.y));
+                }
+
+                std::vector<GtpReply> replies = pachiEngine.sendBatch(cmds);
+                bool ok = true;
+                for(const auto& r : replies) ok = ok && r.success;
+                if(ok)
+                {
+                    seenMoves = moves;
+                    return;
+                }
+                std::cerr << "[PachiBot] Incremental sync failed, rebuilding board.\n";
+            }
+        }
+
+        setBoardSize(size);
+
+        std::vector<std::string> cmds;
+        cmds.push_back("boardsize " + std::to_string(size));
+        cmds.push_back("clear_board");
+        for(const GameMove& m : moves)
+        {
+            cmds.push_back(std::string("play ") + (m.isBlack ? "black " : "white ") + pachiEngine.toGTP(m.x, m.y));
+        }
 
-    std::vector<sf::Vector2i> getDeadStones() override
+        bool ok = true;
+        std::vector<GtpReply> replies = pachiEngine.sendBatch(cmds);
+        for(size_t i = 0; i < replies.size(); ++i)
+        {
+            if(!replies[i].success)
+            {
+                std::cerr << "[PachiBot] Sync failed: " << cmds[i] << " -> " << replies[i].text << "\n";
+                ok = false;
+            }
+        }
+
+        seenMoves = moves;
+        seenBoardSize = size;
+        stateKnown = ok;
+    }
+
+protected:
+    void interruptSearch() override
+    {
+        abortSearch();
+    }
+
+public:
+    PachiBot(int size, int difficulty) : boardSize(size), difficultyLevel(difficulty)
+    { }
+
+    // Lệnh làm đổi bàn (play, undo, clear_board) phải đi qua syncMove / undoMove / syncPosition
+    // để danh sách seenMoves còn khớp với engine
+    std::string sendCommand(std::string cmd)
+    {
+        return pachiEngine.sendCommand(cmd);
+    }
+
+    std::vector<GtpReply> sendBatch(const std::vector<std::string>& cmds)
+    {
+        return pachiEngine.sendBatch(cmds);
+    }
+
+    std::string toGTP(int x, int y)
+    {
+        return pachiEngine.toGTP(x, y);
+    }
+
+    void setBoardSize(int size) override
+    {
+        this->boardSize = size;
+        pachiEngine.setBoardSize(size);
+    }
+
+    // Đổi engine GTP sẽ chạy ở init(); mặc định là Pachi đi kèm trong assets
+    void setEngine(const std::string& path, const std::vector<std::string>& args = {})
+    {
+        enginePath = path;
+        engineArgs = args;
+    }
+
+    // Tùy chọn "pondering" của engine UCT trong Pachi: sau genmove engine tiếp tục nghĩ
+    // trong lượt đối phương và dùng lại cây con khi nhận lệnh play. Có hiệu lực từ lần init() sau
+    void setPondering(bool enabled)
+    {
+        pondering = enabled;
+    }
+
+    // Gọi từ luồng khác trong lúc genmove đang chạy: kill engine để genmove trả về ngay
+    // (không đặt nước nào); thao tác kế tiếp khởi động lại engine
+    void abortSearch()
+    {
+        engineKilled = true;
+        pachiEngine.abort();
+    }
+
+    // Sau genmove engine pondering nghĩ tiếp trong nền cho tới lệnh kế tiếp
+    bool mayBePondering() const
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        return pondering && searched;
+    }
+
+    // Tắt tiến trình engine (dừng cả pondering). Phải init() lại trước khi dùng tiếp
+    void shutdown()
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        pachiEngine.close();
+        engineKilled = false;
+        searched = false;
+        stateKnown = false;
+        seenMoves.clear();
+    }
+
+    // Thời gian nghĩ cho genmove (GTP time_settings); được gửi lại nếu engine phải khởi động lại
+    void setTimeSettings(int mainTime, int byoYomiTime, int byoYomiStones)
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        timeSettings = "time_settings " + std::to_string(mainTime) + " " + std::to_string(byoYomiTime) + " " + std::to_string(byoYomiStones);
+
+        // Engine đã bị kill thì lần khởi động lại sẽ gửi lệnh này
+        if(!engineKilled) pachiEngine.sendCommand(timeSettings);
+    }
+
+    void init() override
+    {
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            stateKnown = false;
+            seenMoves.clear();
+            engineKilled = false;
+        }
+
+        if (!startEngine()) return;
+
+        std::cout << "[PachiBot] Init Finished Successfully.\n";
+
+        std::string test = pachiEngine.sendCommand("name");
+        std::cout << "BOT NAME = " << test << "\n";
+    }
+
+    void syncMove(std::string color, int x, int y)
+    {
+        std::string coord = pachiEngine.toGTP(x, y);
+        std::string cmd = "play " + color + " " + coord;
+
+        std::lock_guard<std::mutex> lock(stateMutex);
+        restartIfKilledLocked();
+        if(runCommand(cmd)) seenMoves.push_back({color == "black" || color == "b", x, y});
+        else stateKnown = false;
+
+//        std::cout << "[PachiBot] Sync: " << cmd << " -> Done." << std::endl;
+    }
+
+    // Gỡ nước cuối trên bàn của engine
+    void undoMove()
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        restartIfKilledLocked();
+        undoLocked();
+    }
+
+    // Số lệnh GTP cần để syncPosition đưa engine tới vị trí moves
+    size_t syncCost(int size, const std::vector<GameMove>& moves) const
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        size_t rebuild = moves.size() + 2;
+        if(engineKilled || !stateKnown || seenBoardSize != size) return rebuild;
+
+        size_t prefix = commonPrefix(moves);
+        size_t incremental = (seenMoves.size() - prefix) + (moves.size() - prefix);
+        return std::min(incremental, rebuild);
+    }
+
+    // Đưa bàn của engine về đúng vị trí moves: từ phần chung với các nước đã gửi thì chỉ cần
+    // undo các nước thừa rồi play các nước khác, nên chi phí theo số nước khác nhau chứ không theo độ dài ván.
+    // Chỉ dựng lại từ clear_board khi không rõ trạng thái hoặc dựng lại còn rẻ hơn
+    void syncPosition(int size, const std::vector<GameMove>& moves)
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        restartIfKilledLocked();
+        syncPositionLocked(size, moves);
+    }
+
+    BotMove generateMove(bool isBlackTurn) override
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        restartIfKilledLocked();
+        bool placed = false;
+        return generateLocked(isBlackTurn, placed);
+    }
+
+    // Hỏi nước đi mà không đổi bàn của engine: genmove rồi gỡ lại nước vừa đặt (nếu có)
+    BotMove suggestMove(bool isBlackTurn)
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        restartIfKilledLocked();
+        bool placed = false;
+        BotMove move = generateLocked(isBlackTurn, placed);
+        if(placed) undoLocked();
+        return move;
+    }
+
+public:
+    std::vector<BoardPoint> getDeadStones() override
     {
-        std::vector<sf::Vector2i> deadPoints;
+        std::vector<BoardPoint> deadPoints;
 
+        std::lock_guard<std::mutex> lock(stateMutex);
+        restartIfKilledLocked();
         std::string response = pachiEngine.sendCommand("final_status_list dead");
 
         if (response.empty()) return deadPoints;
@@ -132,7 +420,7 @@ public:
 
             if (segment.empty()) continue;
 
-            sf::Vector2i p = pachiEngine.fromGTP(segment);
+            BoardPoint p = pachiEngine.fromGTP(segment);
 
             if (p.x != -1 && p.y != -1)
             {
@@ -0,0 +1,200 @@
+#pragma once
+#ifndef _WIN32
+#include <spawn.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <cerrno>
+#include <ctime>
+#include <thread>
+#include "GtpTransport.h"
+
+extern char** environ;
+
+// Engine chạy bằng posix_spawnp, nối qua hai pipe; đọc có thời hạn bằng poll
+class PosixTransport : public GtpTransport
+{
+private:
+    int m_inFd = -1;   // ghi vào stdin của engine
+    int m_outFd = -1;  // đọc stdout của engine
+    pid_t m_pid = -1;
+
+public:
+    ~PosixTransport() { close(); }
+
+    bool start(const std::string& exePath, const std::vector<std::string>& args) override
+    {
+        int inPipe[2];
+        int outPipe[2];
+        if(pipe(inPipe) != 0) return false;
+        if(pipe(outPipe) != 0)
+        {
+            ::close(inPipe[0]);
+            ::close(inPipe[1]);
+            return false;
+        }
+
+        // Đầu của tiến trình cha không được lọt sang engine
+        fcntl(inPipe[1], F_SETFD, FD_CLOEXEC);
+        fcntl(outPipe[0], F_SETFD, FD_CLOEXEC);
+
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_adddup2(&actions, inPipe[0], STDIN_FILENO);
+        posix_spawn_file_actions_adddup2(&actions, outPipe[1], STDOUT_FILENO);
+        posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+        posix_spawn_file_actions_addclose(&actions, inPipe[0]);
+        posix_spawn_file_actions_addclose(&actions, outPipe[1]);
+
+        std::vector<char*> argv;
+        argv.push_back(const_cast<char*>(exePath.c_str()));
+        for(const auto& arg : args)
+        {
+            argv.push_back(const_cast<char*>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        int rc = posix_spawnp(&m_pid, exePath.c_str(), &actions, nullptr, argv.data(), environ);
+        posix_spawn_file_actions_destroy(&actions);
+
+        ::close(inPipe[0]);
+        ::close(outPipe[1]);
+
+        if(rc != 0)
+        {
+            ::close(inPipe[1]);
+            ::close(outPipe[0]);
+            m_pid = -1;
+            return false;
+        }
+
+#ifdef F_SETNOSIGPIPE
+        // macOS/BSD: ghi vào pipe đã đóng trả EPIPE, không phát SIGPIPE
+        fcntl(inPipe[1], F_SETNOSIGPIPE, 1);
+#endif
+
+        m_inFd = inPipe[1];
+        m_outFd = outPipe[0];
+        return true;
+    }
+
+    bool write(const std::string& data) override
+    {
+        if(m_inFd < 0) return false;
+
+#ifndef F_SETNOSIGPIPE
+        // Engine chết giữa chừng thì write trả EPIPE thay vì SIGPIPE giết cả ứng dụng.
+        // Chặn SIGPIPE chỉ trên luồng này trong lúc ghi, không đổi cách xử lý tín hiệu của cả tiến trình
+        sigset_t pipeSet;
+        sigset_t oldSet;
+        sigemptyset(&pipeSet);
+        sigaddset(&pipeSet, SIGPIPE);
+        sigset_t pendingBefore;
+        sigpending(&pendingBefore);
+        bool wasPending = sigismember(&pendingBefore, SIGPIPE);
+        pthread_sigmask(SIG_BLOCK, &pipeSet, &oldSet);
+#endif
+
+        bool ok = true;
+        size_t sent = 0;
+        while(sent < data.size())
+        {
+            ssize_t n = ::write(m_inFd, data.data() + sent, data.size() - sent);
+            if(n < 0)
+            {
+                if(errno == EINTR) continue;
+                ok = false;
+                break;
+            }
+            sent += (size_t)n;
+        }
+
+#ifndef F_SETNOSIGPIPE
+        // Bỏ SIGPIPE do chính lần ghi này sinh ra trước khi mở chặn lại
+        if(!ok && errno == EPIPE && !wasPending)
+        {
+            timespec zero = {0, 0};
+            while(sigtimedwait(&pipeSet, nullptr, &zero) < 0 && errno == EINTR) {}
+        }
+        pthread_sigmask(SIG_SETMASK, &oldSet, nullptr);
+#endif
+        return ok;
+    }
+
+    int read(char* buffer, int size, int timeoutMs) override
+    {
+        if(m_outFd < 0) return -1;
+
+        pollfd pfd;
+        pfd.fd = m_outFd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+
+        int ready;
+        do
+        {
+            ready = poll(&pfd, 1, timeoutMs < 0 ? 0 : timeoutMs);
+        } while(ready < 0 && errno == EINTR);
+
+        if(ready < 0) return -1;
+        if(ready == 0) return 0;
+
+        ssize_t n;
+        do
+        {
+            n = ::read(m_outFd, buffer, (size_t)size);
+        } while(n < 0 && errno == EINTR);
+
+        // n == 0: engine đã đóng stdout (EOF)
+        return n > 0 ? (int)n : -1;
+    }
+
+    void terminate() override
+    {
+        if(m_pid > 0) kill(m_pid, SIGKILL);
+    }
+
+    bool isOpen() const override
+    {
+        return m_inFd >= 0;
+    }
+
+    void close() override
+    {
+        if(m_inFd >= 0)
+        {
+            write("quit\n");
+            ::close(m_inFd);
+            m_inFd = -1;
+        }
+        if(m_outFd >= 0)
+        {
+            ::close(m_outFd);
+            m_outFd = -1;
+        }
+
+        if(m_pid > 0)
+        {
+            // Engine thường đã thoát (nhận "quit" và EOF ở stdin). Nếu chưa thì luồng riêng chờ thêm ~1 giây
+            // rồi kill, để luồng đang hủy Bot không bị chặn
+            if(waitpid(m_pid, nullptr, WNOHANG) == 0)
+            {
+                pid_t pid = m_pid;
+                std::thread([pid]()
+                {
+                    for(int i = 0; i < 100; ++i)
+                    {
+                        if(waitpid(pid, nullptr, WNOHANG) != 0) return;
+                        usleep(10000);
+                    }
+                    kill(pid, SIGKILL);
+                    waitpid(pid, nullptr, 0);
+                }).detach();
+            }
+            m_pid = -1;
+        }
+    }
+};
+#endif
@@ -1,11 +1,38 @@
 #pragma once
 #include <map>
+#include <set>
 #include <string>
 #include <memory>
 #include <list>
+#include <vector>
+#include <deque>
+#include <mutex>
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include <SFML/Window/Cursor.hpp>
+#include "ThreadPool.h"
+#include "AssetArchive.h"
+
+// Một ảnh trong atlas: texture của trang atlas và vùng chữ nhật của ảnh trên trang đó.
+// Ảnh không được gộp thì texture là texture riêng của nó và rect là toàn bộ ảnh
+struct TextureRegion
+{
+    const sf::Texture* texture = nullptr;
+    sf::IntRect rect;
+
+    void applyTo(sf::Sprite& sprite) const
+    {
+        sprite.setTexture(*texture);
+        sprite.setTextureRect(rect);
+    }
+
+    sf::Sprite makeSprite() const
+    {
+        return sf::Sprite(*texture, rect);
+    }
+};
+
+class TextureHandle;
 
 class ResourceManager
 {
@@ -15,10 +42,37 @@ public:
     ResourceManager(ResourceManager const&) = delete;
     void operator=(ResourceManager const&) = delete;
 
-    void loadTexture(const std::string& key, const std::string& filePath);
+    // Đọc tài nguyên từ archive của assetpack (memory map, giải mã bằng loadFromMemory) thay cho file lẻ.
+    // Gọi trước khi nạp; file không có trong archive vẫn đọc từ đĩa
+    bool mountArchive(const std::string& archivePath);
+
+    // packInAtlas = false cho ảnh chỉ dùng nguyên texture (lặp vân, getTexture): giữ texture riêng,
+    // không gộp vào atlas để khỏi phải đọc lại trang atlas từ GPU
+    void loadTexture(const std::string& key, const std::string& filePath, bool packInAtlas = true);
 
+    // Ảnh đã gộp atlas chỉ có texture riêng khi được hỏi lần đầu ở đây (đọc lại từ trang atlas);
+    // chỉ cần vẽ thì dùng getRegion
     sf::Texture& getTexture(const std::string& key);
 
+    // Gộp các ảnh nhỏ đã nạp (nút, quân cờ, icon, bảng) vào vài trang texture lớn để các sprite
+    // dùng chung texture. Gọi một lần sau khi nạp xong; ảnh nạp sau đó vẫn dùng texture riêng
+    void buildAtlas();
+
+    // Vùng của ảnh trong atlas (hoặc toàn bộ texture riêng nếu ảnh không được gộp)
+    const TextureRegion& getRegion(const std::string& key);
+
+    // Ô trắng đặc (nằm trong atlas nếu đã gộp), tô màu bằng màu sprite/đỉnh
+    const TextureRegion& getSolidRegion();
+
+    // Ảnh lớn theo màn hình/theme (nền, bàn cờ): chỉ ghi đường dẫn, nạp khi có màn hình cần tới
+    void registerTexture(const std::string& key, const std::string& filePath);
+
+    // Nạp nếu chưa có; texture được giữ tới khi handle cuối cùng bị hủy
+    TextureHandle acquireTexture(const std::string& key);
+
+    // Texture không còn handle nào giữ được để lại tới khi tổng dung lượng vượt budget, sau đó bỏ cái lâu nhất chưa dùng
+    void setTextureCacheBudget(size_t bytes);
+
     void loadFont(const std::string& key, const std::string& filePath);
 
     sf::Font& getFont(const std::string& key);
@@ -27,6 +81,16 @@ public:
 
     sf::SoundBuffer& getSoundBuffer(const std::string& key);
 
+    // Nạp nền lúc khởi động: queue* chỉ ghi yêu cầu, startLoading() giải mã PNG/WAV/OGG song song trên
+    // nhóm luồng, updateLoading() (luồng chính, mỗi frame) tạo texture/buffer từ dữ liệu đã giải mã
+    void queueTexture(const std::string& key, const std::string& filePath, bool packInAtlas = true);
+    void queueSoundBuffer(const std::string& key, const std::string& filePath);
+    void startLoading(int threadCount = 0);
+
+    // Đưa kết quả lên GPU/OpenAL tới khi hết budget; true khi mọi yêu cầu đã xong và atlas đã dựng
+    bool updateLoading(sf::Time budget);
+    float getLoadingProgress() const;
+
     void loadCursor(const std::string& key, sf::Cursor::Type type);
     sf::Cursor& getCursor(const std::string& key);
 
@@ -44,7 +108,77 @@ public:
 private:
     ResourceManager();
 
-    std::map<std::string, sf::Texture> m_textures;
+    friend class TextureHandle;
+
+    struct LazyTexture
+    {
+        std::string key;
+        std::string path;
+        std::unique_ptr<sf::Texture> texture;
+        size_t bytes = 0;
+        int refCount = 0;
+        bool cached = false;                        // không còn ai giữ nhưng chưa bị bỏ, đang nằm trong m_lazyLru
+        std::list<LazyTexture*>::iterator lruPos;
+    };
+
+    void releaseTexture(LazyTexture& entry);
+    void trimTextureCache();
+
+    // Dữ liệu của file trong archive đã mount; false nếu không có archive hoặc file không nằm trong đó
+    bool findPacked(const std::string& filePath, AssetArchive::Blob& blob) const;
+
+    // Khai báo đầu tiên để hủy sau cùng: font và nhạc mở từ bộ nhớ vẫn đọc vùng map của archive
+    AssetArchive m_archive;
+
+    // Một file cần nạp; nhiều key dùng cùng file chỉ giải mã một lần
+    struct LoadRequest
+    {
+        bool isSound = false;
+        std::string path;
+        std::vector<std::string> keys;
+    };
+
+    struct DecodedResource
+    {
+        LoadRequest request;
+        bool ok = false;
+        sf::Image image;
+        std::vector<sf::Int16> samples;
+        unsigned int channelCount = 0;
+        unsigned int sampleRate = 0;
+    };
+
+    void queueFile(bool isSound, const std::string& key, const std::string& filePath);
+    void addTexture(const std::string& key, const std::string& filePath, const sf::Image& image);
+    void createTexture(const std::string& key, const sf::Image& image);
+
+    // Điểm ảnh của một key đã (hoặc sắp) gộp vào atlas; false nếu key có texture riêng hoặc không tồn tại
+    bool copyAtlasImage(const std::string& key, sf::Image& image) const;
+
+    std::map<std::string, sf::Texture> m_textures;   // texture riêng: ảnh lớn, ảnh nạp sau atlas, bản tách từ atlas
+
+    // Ảnh chờ gộp atlas, theo đường dẫn để ảnh dùng cho nhiều key chỉ chiếm một chỗ
+    std::map<std::string, sf::Image> m_atlasImages;
+    std::map<std::string, std::string> m_atlasKeyPaths;
+    std::set<std::string> m_unpackedKeys;            // key nạp với packInAtlas = false
+    std::vector<std::unique_ptr<sf::Texture>> m_atlasPages;
+    std::map<std::string, TextureRegion> m_regions;
+
+    std::map<std::string, LazyTexture> m_lazyTextures;
+    std::list<LazyTexture*> m_lazyLru;              // đầu danh sách là texture vừa được thả
+    size_t m_lazyResidentBytes = 0;
+    size_t m_lazyCachedBytes = 0;
+    size_t m_lazyBudgetBytes = 16 * 1024 * 1024;
+
+    std::vector<LoadRequest> m_loadQueue;
+    std::mutex m_decodedMutex;
+    std::deque<DecodedResource> m_decoded;   // luồng giải mã đẩy vào, luồng chính lấy ra
+    size_t m_loadTotal = 0;
+    size_t m_loadDone = 0;
+    sf::Clock m_loadClock;
+    // Khai báo sau m_decoded và m_decodedMutex nên bị hủy trước chúng: các luồng giải mã
+    // dừng hẳn trước khi hàng đợi kết quả và khóa của nó bị hủy
+    std::unique_ptr<ThreadPool> m_loaderPool;
     std::map<std::string, sf::Font> m_fonts;
     std::map<std::string, sf::SoundBuffer> m_soundBuffers;
     std::map<std::string, std::unique_ptr<sf::Cursor>> m_cursors;
@@ -57,3 +191,22 @@ private:
     std::list<sf::Sound> m_activeSounds;
 };
 
+// Giữ một texture nạp lười của ResourceManager. Sao chép handle tăng số tham chiếu;
+// handle cuối cùng bị hủy thì texture chuyển vào hàng chờ LRU thay vì bị bỏ ngay
+class TextureHandle
+{
+public:
+    TextureHandle() = default;
+    TextureHandle(const TextureHandle& other);
+    TextureHandle(TextureHandle&& other) noexcept;
+    TextureHandle& operator=(TextureHandle other);
+    ~TextureHandle();
+
+    sf::Texture& get() const;
+
+private:
+    friend class ResourceManager;
+    explicit TextureHandle(ResourceManager::LazyTexture* entry);
+
+    ResourceManager::LazyTexture* m_entry = nullptr;
+};
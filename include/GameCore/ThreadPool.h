@@ -0,0 +1,89 @@
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <queue>
+#include <vector>
+
+// Nhóm luồng cố định: submit() đẩy việc vào hàng đợi, wait() chờ mọi việc đã gửi chạy xong
+class ThreadPool
+{
+private:
+    std::vector<std::thread> m_workers;
+    std::queue<std::function<void()>> m_tasks;
+
+    std::mutex m_mutex;
+    std::condition_variable m_taskReady;
+    std::condition_variable m_allDone;
+
+    int m_pending = 0;
+    bool m_stopping = false;
+
+    void workerLoop()
+    {
+        for(;;)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_taskReady.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+
+                if(m_tasks.empty()) return;
+
+                task = std::move(m_tasks.front());
+                m_tasks.pop();
+            }
+
+            task();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(--m_pending == 0) m_allDone.notify_all();
+        }
+    }
+
+public:
+    explicit ThreadPool(int threads)
+    {
+        if(threads < 1) threads = 1;
+        for(int i = 0; i < threads; ++i)
+        {
+            m_workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_taskReady.notify_all();
+
+        for(auto& t : m_workers)
+        {
+            if(t.joinable()) t.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const { return (int)m_workers.size(); }
+
+    void submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push(std::move(task));
+            m_pending++;
+        }
+        m_taskReady.notify_one();
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_allDone.wait(lock, [this]() { return m_pending == 0; });
+    }
+};
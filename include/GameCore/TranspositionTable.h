@@ -0,0 +1,99 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+
+enum class TTBound : uint8_t { None = 0, Exact = 1, Lower = 2, Upper = 3 };
+
+struct TTEntry
+{
+    int score = 0;
+    int depth = 0;
+    TTBound bound = TTBound::None;
+    int bestMove = -1; // chỉ số bitboard, -1 nếu không có
+};
+
+// Bảng chuyển vị kích thước cố định, không khóa.
+// Mỗi ô gồm hai word atomic: key ^ data và data. Khi đọc, nếu key tính lại
+// không khớp (ghi đè dở dang hoặc va chạm chỉ số) thì coi như không có.
+class TranspositionTable
+{
+private:
+    struct Slot
+    {
+        std::atomic<uint64_t> check{0};
+        std::atomic<uint64_t> data{0};
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_mask = 0;
+    uint8_t m_generation = 0;
+
+    // data: score (32) | depth (8) | bound (2) | move + 1 (10) | generation (8)
+    static uint64_t pack(int score, int depth, TTBound bound, int bestMove, uint8_t generation)
+    {
+        return (uint64_t)(uint32_t)score
+             | ((uint64_t)(depth & 0xFF) << 32)
+             | ((uint64_t)bound << 40)
+             | ((uint64_t)((bestMove + 1) & 0x3FF) << 42)
+             | ((uint64_t)generation << 52);
+    }
+
+public:
+    explicit TranspositionTable(int sizeMB = 16) { resize(sizeMB); }
+
+    void resize(int sizeMB)
+    {
+        size_t bytes = (size_t)(sizeMB > 0 ? sizeMB : 1) * 1024 * 1024;
+        size_t count = 1;
+        while(count * 2 * sizeof(Slot) <= bytes) count *= 2;
+
+        m_slots.reset(new Slot[count]);
+        m_mask = count - 1;
+    }
+
+    void clear()
+    {
+        for(size_t i = 0; i <= m_mask; ++i)
+        {
+            m_slots[i].check.store(0, std::memory_order_relaxed);
+            m_slots[i].data.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Gọi mỗi lượt tìm kiếm mới để mục cũ được ưu tiên ghi đè
+    void newSearch() { m_generation++; }
+
+    bool probe(uint64_t key, TTEntry& out) const
+    {
+        const Slot& slot = m_slots[key & m_mask];
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t check = slot.check.load(std::memory_order_relaxed);
+        if((check ^ data) != key || data == 0) return false;
+
+        out.score = (int)(uint32_t)(data & 0xFFFFFFFFULL);
+        out.depth = (int)((data >> 32) & 0xFF);
+        out.bound = (TTBound)((data >> 40) & 0x3);
+        out.bestMove = (int)((data >> 42) & 0x3FF) - 1;
+        return true;
+    }
+
+    void store(uint64_t key, int score, int depth, TTBound bound, int bestMove)
+    {
+        Slot& slot = m_slots[key & m_mask];
+        uint64_t oldData = slot.data.load(std::memory_order_relaxed);
+        uint64_t oldCheck = slot.check.load(std::memory_order_relaxed);
+
+        // Giữ mục sâu hơn của cùng vị trí trong cùng lượt tìm kiếm
+        bool samePosition = (oldCheck ^ oldData) == key;
+        bool sameGeneration = (uint8_t)(oldData >> 52) == m_generation;
+        int oldDepth = (int)((oldData >> 32) & 0xFF);
+        if(oldData != 0 && sameGeneration && !samePosition && oldDepth > depth) return;
+        if(samePosition && sameGeneration && oldDepth > depth) return;
+
+        uint64_t data = pack(score, depth, bound, bestMove, m_generation);
+        slot.data.store(data, std::memory_order_relaxed);
+        slot.check.store(key ^ data, std::memory_order_relaxed);
+    }
+};
@@ -0,0 +1,204 @@
+#pragma once
+#ifdef _WIN32
+#include <windows.h>
+#include <cstring>
+#include "GtpTransport.h"
+
+// stdout của engine đi qua named pipe mở FILE_FLAG_OVERLAPPED để read() chờ bằng
+// WaitForSingleObject thay vì thăm dò PeekNamedPipe + Sleep (pipe ẩn danh không hỗ trợ overlapped)
+class Win32Transport : public GtpTransport
+{
+private:
+    HANDLE hChildStd_IN_Rd = NULL;
+    HANDLE hChildStd_IN_Wr = NULL;
+    HANDLE hChildStd_OUT_Rd = NULL;
+    HANDLE hChildStd_OUT_Wr = NULL;
+    HANDLE m_process = NULL;
+
+    HANDLE m_readEvent = NULL;
+    OVERLAPPED m_overlapped;
+    bool m_readPending = false;
+
+    // Lệnh ReadFile overlapped ghi vào đây; phần dư được trả dần ở các lần read() sau
+    char m_readBuf[4096];
+    DWORD m_bufStart = 0;
+    DWORD m_bufLen = 0;
+
+    int takeBuffered(char* buffer, int size)
+    {
+        DWORD n = m_bufLen < (DWORD)size ? m_bufLen : (DWORD)size;
+        memcpy(buffer, m_readBuf + m_bufStart, n);
+        m_bufStart += n;
+        m_bufLen -= n;
+        return (int)n;
+    }
+
+public:
+    ~Win32Transport() { close(); }
+
+    bool start(const std::string& exePath, const std::vector<std::string>& args) override
+    {
+        SECURITY_ATTRIBUTES saAttr;
+        saAttr.nLength = sizeof(SECURITY_ATTRIBUTES);
+        saAttr.bInheritHandle = TRUE;
+        saAttr.lpSecurityDescriptor = NULL;
+
+        static LONG pipeCounter = 0;
+        std::string pipeName = "\\\\.\\pipe\\gocore_gtp_" + std::to_string(GetCurrentProcessId())
+                             + "_" + std::to_string(InterlockedIncrement(&pipeCounter));
+
+        // Đầu đọc không kế thừa (security attributes NULL), đầu ghi cho engine thì có
+        hChildStd_OUT_Rd = CreateNamedPipeA(pipeName.c_str(), PIPE_ACCESS_INBOUND | FILE_FLAG_OVERLAPPED,
+                                            PIPE_TYPE_BYTE | PIPE_WAIT, 1, 4096, 4096, 0, NULL);
+        if(hChildStd_OUT_Rd == INVALID_HANDLE_VALUE)
+        {
+            hChildStd_OUT_Rd = NULL;
+            return false;
+        }
+
+        hChildStd_OUT_Wr = CreateFileA(pipeName.c_str(), GENERIC_WRITE, 0, &saAttr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if(hChildStd_OUT_Wr == INVALID_HANDLE_VALUE)
+        {
+            hChildStd_OUT_Wr = NULL;
+            return false;
+        }
+
+        m_readEvent = CreateEventA(NULL, TRUE, FALSE, NULL);
+        if(m_readEvent == NULL) return false;
+        m_readPending = false;
+        m_bufStart = 0;
+        m_bufLen = 0;
+
+        if(!CreatePipe(&hChildStd_IN_Rd, &hChildStd_IN_Wr, &saAttr, 0)) return false;
+        if(!SetHandleInformation(hChildStd_IN_Wr, HANDLE_FLAG_INHERIT, 0)) return false;
+
+        HANDLE hNullFile = CreateFileA("NUL", GENERIC_WRITE, FILE_SHARE_WRITE,
+                                       &saAttr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+        STARTUPINFOA si;
+        PROCESS_INFORMATION pi;
+        ZeroMemory(&si, sizeof(si));
+        si.cb = sizeof(si);
+
+        si.hStdInput = hChildStd_IN_Rd;
+        si.hStdOutput = hChildStd_OUT_Wr;
+        si.hStdError = hNullFile;
+
+        si.dwFlags |= STARTF_USESTDHANDLES | STARTF_USESHOWWINDOW;
+        si.wShowWindow = SW_HIDE;
+
+        ZeroMemory(&pi, sizeof(pi));
+
+        std::string cmdLine = "\"" + exePath + "\"";
+        for(const auto& arg : args)
+        {
+            cmdLine += " \"" + arg + "\"";
+        }
+
+        if(!CreateProcessA(NULL, (LPSTR)cmdLine.c_str(), NULL, NULL, TRUE, 0, NULL, NULL, &si, &pi))
+        {
+            CloseHandle(hNullFile);
+            return false;
+        }
+
+        m_process = pi.hProcess;
+        CloseHandle(pi.hThread);
+        CloseHandle(hChildStd_OUT_Wr);
+        CloseHandle(hChildStd_IN_Rd);
+        CloseHandle(hNullFile);
+        hChildStd_OUT_Wr = NULL;
+        hChildStd_IN_Rd = NULL;
+
+        return true;
+    }
+
+    bool write(const std::string& data) override
+    {
+        if(hChildStd_IN_Wr == NULL) return false;
+
+        DWORD dwWritten;
+        return WriteFile(hChildStd_IN_Wr, data.c_str(), (DWORD)data.length(), &dwWritten, NULL);
+    }
+
+    int read(char* buffer, int size, int timeoutMs) override
+    {
+        if(hChildStd_OUT_Rd == NULL) return -1;
+        if(m_bufLen > 0) return takeBuffered(buffer, size);
+
+        if(!m_readPending)
+        {
+            ZeroMemory(&m_overlapped, sizeof(m_overlapped));
+            m_overlapped.hEvent = m_readEvent;
+
+            DWORD dwRead = 0;
+            if(ReadFile(hChildStd_OUT_Rd, m_readBuf, sizeof(m_readBuf), &dwRead, &m_overlapped))
+            {
+                if(dwRead == 0) return -1;
+                m_bufStart = 0;
+                m_bufLen = dwRead;
+                return takeBuffered(buffer, size);
+            }
+            if(GetLastError() != ERROR_IO_PENDING) return -1;
+            m_readPending = true;
+        }
+
+        // Lệnh đọc đang treo được giữ lại nếu hết giờ, lần gọi sau chờ tiếp
+        DWORD wait = WaitForSingleObject(m_readEvent, timeoutMs < 0 ? 0 : (DWORD)timeoutMs);
+        if(wait == WAIT_TIMEOUT) return 0;
+
+        DWORD dwRead = 0;
+        m_readPending = false;
+        if(wait != WAIT_OBJECT_0 || !GetOverlappedResult(hChildStd_OUT_Rd, &m_overlapped, &dwRead, FALSE) || dwRead == 0)
+        {
+            return -1;
+        }
+
+        m_bufStart = 0;
+        m_bufLen = dwRead;
+        return takeBuffered(buffer, size);
+    }
+
+    void terminate() override
+    {
+        if(m_process) TerminateProcess(m_process, 1);
+    }
+
+    bool isOpen() const override
+    {
+        return hChildStd_IN_Wr != NULL;
+    }
+
+    void close() override
+    {
+        if(hChildStd_IN_Wr)
+        {
+            write("quit\n");
+            CloseHandle(hChildStd_IN_Wr);
+            hChildStd_IN_Wr = NULL;
+        }
+        if(hChildStd_OUT_Rd)
+        {
+            // Hủy lệnh đọc đang treo trước khi giải phóng buffer và event của nó
+            if(m_readPending)
+            {
+                DWORD dwRead;
+                CancelIo(hChildStd_OUT_Rd);
+                GetOverlappedResult(hChildStd_OUT_Rd, &m_overlapped, &dwRead, TRUE);
+                m_readPending = false;
+            }
+            CloseHandle(hChildStd_OUT_Rd);
+            hChildStd_OUT_Rd = NULL;
+        }
+        if(m_readEvent)
+        {
+            CloseHandle(m_readEvent);
+            m_readEvent = NULL;
+        }
+        if(m_process)
+        {
+            CloseHandle(m_process);
+            m_process = NULL;
+        }
+    }
+};
+#endif
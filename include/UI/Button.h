@@ -3,6 +3,7 @@
 #include <SFML/Graphics.hpp>
 #include <functional>
 #include <string>
+#include "ResourceManager.h"
 
 namespace UI
 {
@@ -16,6 +17,11 @@ public:
            const sf::Vector2f& position,
            bool isInteractive = true);
 
+    // Ảnh nút nằm trong atlas của ResourceManager
+    Button(const TextureRegion& region,
+           const sf::Vector2f& position,
+           bool isInteractive = true);
+
     virtual ~Button() = default;
 
     void setPosition(const sf::Vector2f& pos);
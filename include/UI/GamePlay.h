@@ -7,7 +7,6 @@
 #include <memory>
 #include <vector>
 #include <stack> // <-- Cần cho Undo/Redo
-#include <future>
 #include <mutex>
 
 #include "GameState.h"
@@ -19,8 +18,10 @@
 #include "BoardBreathEffect.h"
 #include "SaveDefinition.h" // <-- Cần cho Save/Load info
 #include "ScoringOverlay.h"
+#include "StoneLayer.h"
 #include "IBot.h"
 #include "BotManager.h"
+#include "ThreadPool.h"
 
 // Struct để lưu dữ liệu UI phục vụ Redo
 struct UIActionSnapshot {
@@ -45,7 +46,7 @@ public:
      * @brief Hàm khởi tạo nhận đầy đủ thông tin cài đặt.
      */
     GamePlay(sf::RenderWindow& window, int boardSize, GameMode mode, AiDifficulty difficulty);
-    virtual ~GamePlay() = default;
+    virtual ~GamePlay();
 
     virtual void handleEvent(sf::Event& event) override;
     virtual GameStateType update(float deltaTime) override;
@@ -62,11 +63,30 @@ private:
     sf::Sprite m_loadingSprite;
     // [THÊM] Cờ theo dõi trạng thái Hint đang chạy
     std::atomic<bool> m_isCalculatingHint{false};
+    // Quân chết được tính ở luồng nền như gợi ý; update() áp kết quả trên luồng UI
+    std::atomic<bool> m_isCalculatingScore{false};
+    std::vector<BoardPoint> m_scoredDeadStones;
 
     const float MESSAGE_DURATION = 2.0f;
     float m_messageTimer = 0;
 
-    std::mutex m_workerMutex; // [THÊM] Khóa để bảo vệ Bot Pachi
+    // Mọi lệnh làm đổi bàn của bot (play, undo, đồng bộ lại, genmove) chạy lần lượt trên một luồng,
+    // đúng thứ tự gửi và không chặn luồng UI
+    std::unique_ptr<ThreadPool> m_botWorker;
+    std::atomic<bool> m_closing{false};
+
+    // Đánh số lượt AI: startMove còn trong hàng đợi mà lượt đã bị hủy thì bỏ qua
+    std::mutex m_aiTurnMutex;
+    int m_aiTurnId = 0;
+
+    // Gợi ý và đếm quân chết mượn engine riêng trong pool nên chạy trên luồng khác, song song với lượt
+    // nghĩ của đối thủ. m_hintEngine là engine gợi ý đang nghĩ, bị ngắt khi đóng màn hình
+    std::unique_ptr<ThreadPool> m_analysisWorker;
+    std::mutex m_hintEngineMutex;
+    std::shared_ptr<PachiBot> m_hintEngine;
+
+    // Gửi việc cho m_botWorker; việc chỉ chạy sau khi lượt tìm kiếm trước đó của bot (kể cả đã hủy) kết thúc
+    void postBotTask(const std::shared_ptr<IBot>& bot, std::function<void()> task);
 
     // --- Xử lý Input (Callbacks) ---
     void onBoardClick(int mouseX, int mouseY);
@@ -80,6 +100,8 @@ private:
     void showMessage(const std::string& msg, MsgType type = MsgType::Info);
 
     void requestHintFromBot();
+    void requestDeadStones();
+    void applyDeadStones();
 
     // Hàm đồng bộ nước đi cho tất cả bot (tránh gửi trùng nếu 2 bot là 1)
     void syncToAllBots(const std::string& color, int x, int y);
@@ -127,12 +149,14 @@ private:
     sf::Clock m_moveTimer;
 
     // --- UI Components (Sprite & Text) ---
+    TextureHandle m_backgroundTexture;
     sf::Sprite m_background;
+    TextureHandle m_boardTexture;   // đổi theme thì giữ bàn mới rồi mới thả bàn cũ
     sf::Sprite m_boardSprite;
     sf::Sprite m_turnactionBackground;
     sf::Sprite m_logBackground;
-    sf::Texture* m_blackStoneTex;
-    sf::Texture* m_whiteStoneTex;
+    const TextureRegion* m_blackStoneRegion;   // quân cờ trong atlas (StoneLayer, quân ma)
+    const TextureRegion* m_whiteStoneRegion;
     sf::Font& m_font;
     sf::Text m_messageText;
     sf::Text m_turnText;
@@ -176,9 +200,12 @@ private:
     // Tọa độ nước đi cuối cùng (-1, -1 nếu chưa đi hoặc vừa Undo)
     sf::Vector2i m_lastMoveCoord;
 
-    // Hình vuông đỏ đánh dấu
+    // Hình vuông đỏ đánh dấu (kích thước, màu; được vẽ trong m_stoneLayer)
     sf::RectangleShape m_lastMoveMarker;
 
+    // Toàn bộ quân trên bàn, vẽ trong một draw call
+    UI::StoneLayer m_stoneLayer;
+
     sf::Sound m_soundPlaceBlack; // Đặt quân (có thể dùng chung hoặc tách tùy bạn)
     sf::Sound m_soundPlaceWhite; // Đặt quân (có thể dùng chung hoặc tách tùy bạn)
 
@@ -244,10 +271,13 @@ private:
     // [THÊM MỚI] --- BOT & THREADING ---
     // [SỬA] Đổi thành shared_ptr
     std::shared_ptr<IBot> m_bot;
-    std::future<BotMove> m_aiFuture;
     bool m_isAiThinkingWorker = false;
 
-    std::vector<sf::Vector2i> m_deadStones;
+    // Hủy lượt tìm nước đang chạy của bot (undo, đầu hàng, rời màn hình).
+    // true nếu bỏ một nước bot đã tìm xong mà chưa đặt lên bàn UI
+    bool cancelAiMove();
+
+    std::vector<BoardPoint> m_deadStones;
 
     // [THÊM] Biến lưu nước đi chờ đồng bộ
     PendingMove m_pendingPlayerMove;
@@ -261,5 +291,6 @@ private:
     // [THÊM] Hàm helper để chạy logic khởi tạo
 
 
-    void performSyncBoardInternal();
+    void performSyncBoardInternal(const std::shared_ptr<IBot>& bot, int size,
+                                  const std::vector<std::vector<StoneType>>& board, const std::vector<GameMove>& history);
 };
@@ -6,6 +6,7 @@
 #include <vector>
 #include <memory>
 #include "Slider.h"
+#include "ResourceManager.h"
 
 namespace UI
 {
@@ -26,8 +27,8 @@ public:
     HistoryList(sf::Vector2f position, sf::Vector2f size,
                 const sf::Texture& bgTex,
                 const sf::Texture& sliderTrack,
-                const sf::Texture& blackIconTex,
-                const sf::Texture& whiteIconTex,
+                const TextureRegion& blackIcon,
+                const TextureRegion& whiteIcon,
                 const sf::Font& font);
     ~HistoryList() = default;
 
@@ -39,7 +40,7 @@ public:
     void removeLastMove(); // Xóa dòng cuối
     void clear();
 
-    void updateTheme(const sf::Texture* blackTex, const sf::Texture* whiteTex);
+    void updateTheme(const TextureRegion* blackIcon, const TextureRegion* whiteIcon);
 
     std::string getLastMoveNotation() const;
 
@@ -57,8 +58,8 @@ private:
     float m_totalContentHeight;
     bool m_isScrollbarVisible;
 
-    const sf::Texture* m_blackStoneTex;
-    const sf::Texture* m_whiteStoneTex;
+    const TextureRegion* m_blackStoneIcon;
+    const TextureRegion* m_whiteStoneIcon;
     const sf::Font& m_font;
 };
 
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "GameState.h"
+#include "ResourceManager.h"
+
+// Màn hình đầu tiên: mỗi frame đưa một phần tài nguyên đã giải mã lên GPU, xong thì sang MainMenu
+class LoadingScreen : public GameState
+{
+public:
+    LoadingScreen(sf::RenderWindow& window);
+    virtual ~LoadingScreen() = default;
+
+    virtual void handleEvent(sf::Event& event) override;
+    virtual GameStateType update(float deltaTime) override;
+    virtual void draw() override;
+
+private:
+    void createUI();
+
+    sf::RenderWindow& m_window;
+
+    sf::Text m_titleText;
+    sf::Text m_percentText;
+    sf::RectangleShape m_barBackground;
+    sf::RectangleShape m_barFill;
+};
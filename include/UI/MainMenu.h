@@ -32,6 +32,7 @@ private:
 
     sf::RenderWindow& m_window;
     GameStateType m_requestedState;
+    TextureHandle m_backgroundTexture;
     sf::Sprite m_backgroundSprite;
 
     UI::Button m_NewGameBtn;
@@ -34,6 +34,7 @@ private:
 
     sf::RenderWindow& m_window;
     GameStateType m_requestedState;
+    TextureHandle m_backgroundTexture;
     sf::Sprite m_backgroundSprite;
 
     UI::Button m_pvpBtn;
@@ -33,6 +33,7 @@ private:
 
     sf::RenderWindow& m_window;
     GameStateType m_requestedState;
+    TextureHandle m_backgroundTexture;
     sf::Sprite m_backgroundSprite;
 
     sf::RenderTexture m_renderTexture;
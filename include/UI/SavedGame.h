@@ -43,6 +43,7 @@ private:
 
     sf::RenderWindow& m_window;
     GameStateType m_requestedState;
+    TextureHandle m_backgroundTexture;
     sf::Sprite m_background;
     UI::Button m_backBtn;
 
@@ -47,6 +47,7 @@ private:
     GameStateType m_requestedState;
     GameStateType m_backState;
 
+    TextureHandle m_backgroundTexture;
     sf::Sprite m_backgroundSprite;
 
     sf::RenderTexture m_renderTexture;
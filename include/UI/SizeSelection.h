@@ -40,6 +40,7 @@ private:
 
     sf::RenderWindow& m_window;
     GameStateType m_requestedState;
+    TextureHandle m_backgroundTexture;
     sf::Sprite m_background;
 
     GameMode m_currentMode;
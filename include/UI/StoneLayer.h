@@ -0,0 +1,90 @@
+// include/StoneLayer.h
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "GameLogic.h"
+#include "ResourceManager.h"
+
+namespace UI
+{
+
+// Vẽ toàn bộ quân trên bàn bằng một VertexArray duy nhất.
+// Quân đen, quân trắng và ô màu trắng (cho dấu nước cuối) lấy từ atlas của ResourceManager, nên cả bàn chỉ tốn một draw call.
+// Nếu ba ảnh không cùng một trang atlas thì tự gộp chúng vào một RenderTexture riêng
+// Mỗi frame GamePlay khai báo trạng thái từng ô; lưới đỉnh chỉ dựng lại khi trạng thái khác lần dựng trước
+class StoneLayer : public sf::Drawable
+{
+public:
+    StoneLayer();
+
+    // Đổi theme quân: chọn lại texture nếu ảnh khác lần trước
+    void setTextures(const TextureRegion& black, const TextureRegion& white);
+
+    // Tâm ô (x, y) nằm tại (left + x * spacing, top + y * spacing)
+    void setLayout(int boardSize, float left, float top, float spacing);
+
+    // alpha < 255 cho quân gợi ý; StoneType::Empty là ô trống
+    void setStone(int x, int y, StoneType stone, float scale, sf::Uint8 alpha = 255);
+
+    // Dấu vuông vẽ đè lên quân tại (x, y); x < 0 là không vẽ
+    void setLastMoveMarker(int x, int y, float size, sf::Color color);
+
+    // Gọi trước khi vẽ
+    void rebuildIfNeeded();
+
+private:
+    struct Cell
+    {
+        StoneType stone = StoneType::Empty;
+        float scale = 1.f;
+        sf::Uint8 alpha = 255;
+
+        bool operator==(const Cell& other) const
+        {
+            return stone == other.stone && scale == other.scale && alpha == other.alpha;
+        }
+        bool operator!=(const Cell& other) const { return !(*this == other); }
+    };
+
+    struct Marker
+    {
+        int x = -1;
+        int y = -1;
+        float size = 0.f;
+        sf::Color color = sf::Color::Red;
+
+        bool operator==(const Marker& other) const
+        {
+            return x == other.x && y == other.y && size == other.size && color == other.color;
+        }
+    };
+
+    void buildOwnAtlas(const TextureRegion& black, const TextureRegion& white, const TextureRegion& solid);
+    void appendQuad(sf::Vector2f center, sf::Vector2f halfSize, const sf::FloatRect& texRect, sf::Color color);
+
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    const TextureRegion* m_blackRegion;
+    const TextureRegion* m_whiteRegion;
+    const sf::Texture* m_texture;
+    sf::RenderTexture m_ownAtlas;
+    sf::FloatRect m_blackRect;
+    sf::FloatRect m_whiteRect;
+    sf::FloatRect m_solidRect;   // vùng trắng đặc, tô màu bằng màu đỉnh
+
+    int m_boardSize;
+    sf::Vector2f m_topLeft;
+    float m_spacing;
+
+    // Trạng thái yêu cầu trong frame này và trạng thái đã dựng thành m_vertices
+    std::vector<Cell> m_cells;
+    std::vector<Cell> m_builtCells;
+    Marker m_marker;
+    Marker m_builtMarker;
+    bool m_dirty;
+
+    sf::VertexArray m_vertices;
+};
+
+}
@@ -0,0 +1,333 @@
+#include "Arena.h"
+#include "MiniMaxBot.h"
+#include "MCTSBot.h"
+#include "PachiBot.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <filesystem>
+#include <mutex>
+
+namespace
+{
+    // Số nút MCTSBot tạo được mỗi ms trên một luồng, dùng để cỡ vùng nút theo thời gian mỗi nước
+    const int MCTS_NODES_PER_MS = 1000;
+}
+
+// ================= ArenaBotConfig =================
+
+bool ArenaBotConfig::parse(const std::string& spec, ArenaBotConfig& out)
+{
+    std::vector<std::string> parts;
+    std::stringstream ss(spec);
+    std::string part;
+    while(std::getline(ss, part, ':')) parts.push_back(part);
+
+    if(parts.empty()) return false;
+
+    ArenaBotConfig config;
+    config.engine = parts[0];
+    if(config.engine != "minimax" && config.engine != "mcts" && config.engine != "pachi") return false;
+
+    try
+    {
+        if(parts.size() > 1) config.timeMs = std::stoi(parts[1]);
+    }
+    catch(...)
+    {
+        return false;
+    }
+    if(config.timeMs <= 0) return false;
+
+    if(config.engine == "mcts")
+    {
+        if(parts.size() > 3) return false;
+        try
+        {
+            if(parts.size() > 2) config.maxNodes = std::stoi(parts[2]);
+        }
+        catch(...)
+        {
+            return false;
+        }
+        if(config.maxNodes < 0) return false;
+
+        out = config;
+        return true;
+    }
+
+    // Đường dẫn Windows có thể chứa ':' (C:\...), ghép lại phần còn lại
+    for(size_t i = 2; i < parts.size(); ++i)
+    {
+        if(i > 2) config.enginePath += ":";
+        config.enginePath += parts[i];
+    }
+
+    out = config;
+    return true;
+}
+
+std::string ArenaBotConfig::name() const
+{
+    std::string result = engine + ":" + std::to_string(timeMs);
+    if(engine == "mcts" && maxNodes > 0) result += ":" + std::to_string(maxNodes);
+    return result;
+}
+
+// ================= MoveTiming =================
+
+void MoveTiming::add(double ms)
+{
+    count++;
+    totalMs += ms;
+    if(ms > maxMs) maxMs = ms;
+}
+
+// ================= Arena =================
+
+Arena::Arena(const ArenaConfig& config) : m_config(config)
+{
+    if(m_config.maxMoves <= 0) m_config.maxMoves = m_config.boardSize * m_config.boardSize * 3;
+    if(m_config.concurrency <= 0)
+    {
+        unsigned int cores = std::thread::hardware_concurrency();
+        m_config.concurrency = cores > 0 ? (int)cores : 1;
+    }
+}
+
+std::shared_ptr<IBot> Arena::createBot(const ArenaBotConfig& config, uint64_t seed) const
+{
+    if(config.engine == "minimax")
+    {
+        // Mỗi ván đã chiếm một lõi nên MiniMax tìm tuần tự
+        auto bot = std::make_shared<MiniMaxBot>(m_config.boardSize, config.depth);
+        bot->setTimeLimit(config.timeMs);
+        bot->setThreadCount(1);
+        return bot;
+    }
+
+    if(config.engine == "pachi")
+    {
+        auto bot = std::make_shared<PachiBot>(m_config.boardSize, 3);
+        if(!config.enginePath.empty()) bot->setEngine(config.enginePath);
+        return bot;
+    }
+
+    // Mỗi ván chạy một luồng và --jobs mặc định bằng số lõi, nên không dùng vùng nút 1<<20 mặc định
+    // (~28 MB, gấp đôi khi nén cây) cho mọi bot: cỡ theo số nút một lượt kịp tạo
+    int maxNodes = config.maxNodes;
+    if(maxNodes <= 0) maxNodes = (int)std::min<long long>((long long)config.timeMs * MCTS_NODES_PER_MS, 1 << 20);
+    maxNodes = std::max(maxNodes, 4096);
+
+    auto bot = std::make_shared<MCTSBot>(m_config.boardSize, config.timeMs, maxNodes);
+    bot->setKomi(m_config.komi);
+    bot->setSeed(seed);
+    return bot;
+}
+
+ArenaGameResult Arena::playGame(int index) const
+{
+    ArenaGameResult result;
+    result.index = index;
+    result.aIsBlack = (index % 2 == 0);
+
+    const ArenaBotConfig& blackConfig = result.aIsBlack ? m_config.botA : m_config.botB;
+    const ArenaBotConfig& whiteConfig = result.aIsBlack ? m_config.botB : m_config.botA;
+
+    uint64_t seed = m_config.seed * 1000003ULL + (uint64_t)index * 2;
+    std::shared_ptr<IBot> bots[2] = { createBot(blackConfig, seed + 1), createBot(whiteConfig, seed + 2) };
+    for(auto& bot : bots) bot->init();
+
+    if(auto pachi = std::dynamic_pointer_cast<PachiBot>(bots[0]))
+    {
+        pachi->sendCommand("komi " + std::to_string(m_config.komi));
+        pachi->setTimeSettings(0, (blackConfig.timeMs + 999) / 1000, 1);
+    }
+    if(auto pachi = std::dynamic_pointer_cast<PachiBot>(bots[1]))
+    {
+        pachi->sendCommand("komi " + std::to_string(m_config.komi));
+        pachi->setTimeSettings(0, (whiteConfig.timeMs + 999) / 1000, 1);
+    }
+
+    // Trọng tài đếm quân chết cuối ván, không phụ thuộc bot nào đang thi đấu
+    MCTSBot referee(m_config.boardSize, 0, 1024);
+    referee.init();
+
+    GameLogic logic(m_config.boardSize);
+    logic.newGame();
+
+    auto gameStart = std::chrono::steady_clock::now();
+    bool gameEnded = false;
+    int resignedColor = -1;
+
+    while(!gameEnded && result.moves < m_config.maxMoves)
+    {
+        int side = logic.isBlacksTurn() ? 0 : 1;
+        std::string color = side == 0 ? "black" : "white";
+
+        auto t0 = std::chrono::steady_clock::now();
+        BotMove move = bots[side]->generateMove(side == 0);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        (side == 0 ? result.black : result.white).add(ms);
+
+        if(move.isResign)
+        {
+            resignedColor = side;
+            break;
+        }
+
+        int x = -1;
+        int y = -1;
+        bool illegal = false;
+        MoveResult moveResult;
+        if(!move.isPass)
+        {
+            moveResult = logic.attemptMove(move.x, move.y);
+            if(moveResult.success)
+            {
+                x = move.x;
+                y = move.y;
+            }
+            else
+            {
+                illegal = true;
+                result.illegalMoves++;
+            }
+        }
+        if(x < 0)
+        {
+            moveResult = logic.attemptPass();
+        }
+        gameEnded = moveResult.gameEnded;
+        result.moves++;
+
+        // Pachi đã tự đặt nước của mình khi genmove (như GamePlay); nước sai bị đổi thành pass thì gỡ lại
+        auto pachi = std::dynamic_pointer_cast<PachiBot>(bots[side]);
+        if(!pachi)
+        {
+            bots[side]->syncMove(color, x, y);
+        }
+        else if(illegal)
+        {
+            pachi->undoMove();
+            pachi->syncMove(color, x, y);
+        }
+        bots[1 - side]->syncMove(color, x, y);
+        referee.syncMove(color, x, y);
+    }
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - gameStart).count();
+
+    if(resignedColor >= 0)
+    {
+        result.result = resignedColor == 0 ? "W+R" : "B+R";
+        int winnerColor = 1 - resignedColor;
+        result.winner = (winnerColor == 0) == result.aIsBlack ? 0 : 1;
+    }
+    else
+    {
+        std::vector<DeadStoneInfo> dead;
+        for(const auto& p : referee.getDeadStones())
+        {
+            StoneType type = logic.getStoneAt(p.x, p.y);
+            dead.push_back({p, type == StoneType::Black ? TerritoryOwner::Black : TerritoryOwner::White});
+        }
+
+        ScoreData score = logic.calculateScore(dead, m_config.komi);
+        float blackTotal = score.blackStones + score.blackTerritory;
+        float whiteTotal = score.whiteStones + score.whiteTerritory + score.komi;
+
+        std::ostringstream re;
+        if(blackTotal == whiteTotal)
+        {
+            re << "0";
+        }
+        else
+        {
+            bool blackWins = blackTotal > whiteTotal;
+            re << (blackWins ? "B+" : "W+") << std::abs(blackTotal - whiteTotal);
+            result.winner = blackWins == result.aIsBlack ? 0 : 1;
+        }
+        result.result = re.str();
+    }
+
+    std::filesystem::path sgfPath = std::filesystem::path(m_config.outputDir) / ("game_" + std::to_string(index + 1) + ".sgf");
+    std::ofstream sgf(sgfPath);
+    if(sgf)
+    {
+        sgf << toSgf(result, logic.getMoveHistory());
+        result.sgfPath = sgfPath.string();
+    }
+
+    return result;
+}
+
+std::string Arena::toSgf(const ArenaGameResult& result, const std::vector<GameMove>& moves) const
+{
+    const ArenaBotConfig& blackConfig = result.aIsBlack ? m_config.botA : m_config.botB;
+    const ArenaBotConfig& whiteConfig = result.aIsBlack ? m_config.botB : m_config.botA;
+
+    std::ostringstream out;
+    out << "(;GM[1]FF[4]CA[UTF-8]AP[GoCoreArena]"
+        << "SZ[" << m_config.boardSize << "]KM[" << m_config.komi << "]"
+        << "PB[" << blackConfig.name() << "]PW[" << whiteConfig.name() << "]"
+        << "RE[" << result.result << "]\n";
+
+    // Tọa độ SGF: cột rồi hàng, 'a' là góc trên bên trái; pass là []
+    for(const GameMove& m : moves)
+    {
+        out << ";" << (m.isBlack ? "B" : "W") << "[";
+        if(m.x >= 0) out << (char)('a' + m.x) << (char)('a' + m.y);
+        out << "]";
+    }
+    out << ")\n";
+    return out.str();
+}
+
+std::vector<ArenaGameResult> Arena::run()
+{
+    std::filesystem::create_directories(m_config.outputDir);
+
+    std::vector<ArenaGameResult> results(m_config.games);
+    std::mutex printMutex;
+
+    {
+        ThreadPool pool(std::min(m_config.concurrency, m_config.games));
+        for(int i = 0; i < m_config.games; ++i)
+        {
+            pool.submit([this, i, &results, &printMutex]()
+            {
+                results[i] = playGame(i);
+
+                const ArenaGameResult& r = results[i];
+                std::lock_guard<std::mutex> lock(printMutex);
+                std::cout << "[Arena] Game " << (i + 1) << "/" << m_config.games << ": "
+                          << (r.aIsBlack ? "A" : "B") << " black, " << r.result << ", "
+                          << r.moves << " moves, " << std::fixed << std::setprecision(1) << r.seconds << "s\n";
+            });
+        }
+        pool.wait();
+    }
+
+    std::ofstream csv(std::filesystem::path(m_config.outputDir) / "results.csv");
+    csv << "game,black,white,result,winner,moves,illegal,seconds,"
+           "black_avg_ms,black_max_ms,white_avg_ms,white_max_ms,sgf\n";
+    for(const auto& r : results)
+    {
+        const ArenaBotConfig& blackConfig = r.aIsBlack ? m_config.botA : m_config.botB;
+        const ArenaBotConfig& whiteConfig = r.aIsBlack ? m_config.botB : m_config.botA;
+
+        csv << (r.index + 1) << "," << blackConfig.name() << "," << whiteConfig.name() << ","
+            << r.result << "," << (r.winner == 0 ? "A" : r.winner == 1 ? "B" : "-") << ","
+            << r.moves << "," << r.illegalMoves << "," << std::fixed << std::setprecision(3) << r.seconds << ","
+            << std::setprecision(1) << r.black.averageMs() << "," << r.black.maxMs << ","
+            << r.white.averageMs() << "," << r.white.maxMs << "," << r.sgfPath << "\n";
+    }
+
+    return results;
+}
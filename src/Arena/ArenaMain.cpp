@@ -0,0 +1,113 @@
+#include "Arena.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <cmath>
+
+namespace
+{
+    void printUsage(const char* exe)
+    {
+        std::cout << "Usage: " << exe << " [options]\n"
+                  << "  --a SPEC         bot A, SPEC = engine[:timeMs[:path]] (minimax, mcts, pachi). Default mcts:1000\n"
+                  << "                   for mcts the third field is the tree size in nodes (default: from timeMs)\n"
+                  << "  --b SPEC         bot B. Default minimax:1000\n"
+                  << "  --games N        number of games, colors alternate (default 10)\n"
+                  << "  --size N         board size 9/13/19 (default 9)\n"
+                  << "  --komi K         komi (default 6.5)\n"
+                  << "  --jobs N         games played concurrently (default: number of cores)\n"
+                  << "  --max-moves N    stop and score after N moves (default size*size*3)\n"
+                  << "  --seed N         base seed for MCTS bots (default 1)\n"
+                  << "  --out DIR        output directory for SGF and results.csv (default arena_out)\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    ArenaConfig config;
+    ArenaBotConfig::parse("mcts:1000", config.botA);
+    ArenaBotConfig::parse("minimax:1000", config.botB);
+
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if(arg == "-h" || arg == "--help")
+        {
+            printUsage(argv[0]);
+            return 0;
+        }
+        if(i + 1 >= argc)
+        {
+            std::cerr << "Missing value for " << arg << "\n";
+            return 1;
+        }
+
+        std::string value = argv[++i];
+        bool ok = true;
+        if(arg == "--a") ok = ArenaBotConfig::parse(value, config.botA);
+        else if(arg == "--b") ok = ArenaBotConfig::parse(value, config.botB);
+        else if(arg == "--games") config.games = std::atoi(value.c_str());
+        else if(arg == "--size") config.boardSize = std::atoi(value.c_str());
+        else if(arg == "--komi") config.komi = (float)std::atof(value.c_str());
+        else if(arg == "--jobs") config.concurrency = std::atoi(value.c_str());
+        else if(arg == "--max-moves") config.maxMoves = std::atoi(value.c_str());
+        else if(arg == "--seed") config.seed = std::strtoull(value.c_str(), nullptr, 10);
+        else if(arg == "--out") config.outputDir = value;
+        else ok = false;
+
+        if(!ok)
+        {
+            std::cerr << "Invalid option: " << arg << " " << value << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if(config.games <= 0 || (config.boardSize != 9 && config.boardSize != 13 && config.boardSize != 19))
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::cout << "[Arena] A = " << config.botA.name() << ", B = " << config.botB.name()
+              << ", " << config.games << " games on " << config.boardSize << "x" << config.boardSize << "\n";
+
+    Arena arena(config);
+    std::vector<ArenaGameResult> results = arena.run();
+
+    int winsA = 0;
+    int winsB = 0;
+    MoveTiming timingA;
+    MoveTiming timingB;
+    for(const auto& r : results)
+    {
+        if(r.winner == 0) winsA++;
+        else if(r.winner == 1) winsB++;
+
+        // Gộp thời gian theo bot (không theo màu)
+        const MoveTiming& a = r.aIsBlack ? r.black : r.white;
+        const MoveTiming& b = r.aIsBlack ? r.white : r.black;
+        timingA.count += a.count;
+        timingA.totalMs += a.totalMs;
+        if(a.maxMs > timingA.maxMs) timingA.maxMs = a.maxMs;
+        timingB.count += b.count;
+        timingB.totalMs += b.totalMs;
+        if(b.maxMs > timingB.maxMs) timingB.maxMs = b.maxMs;
+    }
+
+    // Sai số chuẩn của tỉ lệ thắng, đủ để biết kết quả có ý nghĩa hay không
+    int n = (int)results.size();
+    double rate = n ? (winsA + 0.5 * (n - winsA - winsB)) / n : 0.0;
+    double stderrRate = n ? std::sqrt(rate * (1.0 - rate) / n) : 0.0;
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "[Arena] A " << config.botA.name() << ": " << winsA << " wins, "
+              << "avg " << timingA.averageMs() << " ms/move, max " << timingA.maxMs << " ms\n"
+              << "[Arena] B " << config.botB.name() << ": " << winsB << " wins, "
+              << "avg " << timingB.averageMs() << " ms/move, max " << timingB.maxMs << " ms\n"
+              << "[Arena] A score rate " << rate * 100.0 << "% +/- " << stderrRate * 100.0 << "%\n"
+              << "[Arena] Results written to " << config.outputDir << "/results.csv\n";
+
+    return 0;
+}
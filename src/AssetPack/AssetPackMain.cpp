@@ -0,0 +1,92 @@
+#include "AssetArchive.h"
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Gói mọi file trong các thư mục tài nguyên vào một archive cho ResourceManager::mountArchive.
+// Chạy từ thư mục gốc của repo để đường dẫn trong archive khớp với đường dẫn trong main.cpp
+namespace
+{
+    void printUsage(const char* exe)
+    {
+        std::cout << "Usage: " << exe << " [--out FILE] [DIR...]\n"
+                  << "  --out FILE   archive to write (default resources.pak)\n"
+                  << "  DIR          directories to pack, relative to the game's working directory (default resources)\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    namespace fs = std::filesystem;
+
+    std::string outPath = "resources.pak";
+    std::vector<std::string> roots;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if(arg == "-h" || arg == "--help")
+        {
+            printUsage(argv[0]);
+            return 0;
+        }
+        if(arg == "--out" && i + 1 < argc) outPath = argv[++i];
+        else if(!arg.empty() && arg[0] != '-') roots.push_back(arg);
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if(roots.empty()) roots.push_back("resources");
+
+    std::vector<std::string> files;
+    for(const std::string& root : roots)
+    {
+        std::error_code ec;
+        for(fs::recursive_directory_iterator it(root, ec), end; !ec && it != end; it.increment(ec))
+        {
+            if(it->is_regular_file()) files.push_back(it->path().generic_string());
+        }
+        if(ec)
+        {
+            std::cerr << "Cannot read " << root << ": " << ec.message() << "\n";
+            return 1;
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    std::string error;
+    if(!AssetArchive::write(outPath, files, error))
+    {
+        std::cerr << error << "\n";
+        return 1;
+    }
+
+    // Mở lại và tra từng file để chắc archive đọc được
+    AssetArchive archive;
+    if(!archive.open(outPath))
+    {
+        std::cerr << "Cannot reopen " << outPath << "\n";
+        return 1;
+    }
+
+    unsigned long long totalBytes = 0;
+    for(const std::string& file : files)
+    {
+        AssetArchive::Blob blob;
+        if(!archive.find(file, blob) || blob.size != fs::file_size(file))
+        {
+            std::cerr << "Verification failed for " << file << "\n";
+            return 1;
+        }
+        totalBytes += blob.size;
+    }
+
+    std::cout << "[AssetPack] " << files.size() << " files, " << std::fixed << std::setprecision(1)
+              << totalBytes / (1024.0 * 1024.0) << " MB -> " << outPath << "\n";
+    return 0;
+}
@@ -0,0 +1,320 @@
+#include "GameLogic.h"
+#include "SaveDefinition.h"
+#include "BenchGames.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Benchmark các đường nóng của GameLogic trên ván thật (9x9, 13x13, 19x19).
+// Kết quả JSON theo định dạng của Google Benchmark (context + benchmarks) để dùng lại công cụ so sánh sẵn có
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    double g_minTimeSeconds = 0.2;  // thời gian tối thiểu cho mỗi lần lặp đo
+    const int REPETITIONS = 5;       // số lần đo, báo cáo trung vị
+
+    // Ngăn trình biên dịch bỏ phần tính toán không dùng tới
+    volatile long long g_sink = 0;
+
+    struct BenchResult
+    {
+        std::string name;
+        std::string label;
+        int boardSize = 0;
+        long long iterations = 0;   // số thao tác trong mỗi lần đo
+        double realNs = 0.0;        // trung vị, ns mỗi thao tác
+        double cpuNs = 0.0;
+        double minNs = 0.0;
+        double maxNs = 0.0;
+    };
+
+    // body() chạy một lô và trả về số thao tác trong lô. Số lô được nhân đôi tới khi một lần đo
+    // kéo dài ít nhất g_minTimeSeconds, sau đó đo REPETITIONS lần
+    BenchResult runBenchmark(const std::string& name, const std::string& label, int boardSize,
+                             const std::function<long long()>& body)
+    {
+        long long batches = 1;
+        for(;;)
+        {
+            auto t0 = Clock::now();
+            for(long long b = 0; b < batches; ++b) body();
+            double elapsed = std::chrono::duration<double>(Clock::now() - t0).count();
+            if(elapsed >= g_minTimeSeconds || batches >= (1LL << 30)) break;
+
+            double scale = elapsed > 0.0 ? g_minTimeSeconds / elapsed * 1.2 : 10.0;
+            batches = std::max(batches * 2, (long long)(batches * std::min(scale, 100.0)));
+        }
+
+        std::vector<double> realTimes;
+        std::vector<double> cpuTimes;
+        long long ops = 0;
+        for(int r = 0; r < REPETITIONS; ++r)
+        {
+            ops = 0;
+            std::clock_t c0 = std::clock();
+            auto t0 = Clock::now();
+            for(long long b = 0; b < batches; ++b) ops += body();
+            double realNs = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+            double cpuNs = (double)(std::clock() - c0) * 1e9 / CLOCKS_PER_SEC;
+
+            realTimes.push_back(realNs / ops);
+            cpuTimes.push_back(cpuNs / ops);
+        }
+
+        BenchResult result;
+        result.name = name + "/" + std::to_string(boardSize);
+        result.label = label;
+        result.boardSize = boardSize;
+        result.iterations = ops;
+
+        std::sort(realTimes.begin(), realTimes.end());
+        std::sort(cpuTimes.begin(), cpuTimes.end());
+        result.realNs = realTimes[REPETITIONS / 2];
+        result.cpuNs = cpuTimes[REPETITIONS / 2];
+        result.minNs = realTimes.front();
+        result.maxNs = realTimes.back();
+
+        std::fprintf(stderr, "%-32s %12.1f ns/op  (min %.1f, max %.1f, %lld ops)\n",
+                     result.name.c_str(), result.realNs, result.minNs, result.maxNs, result.iterations);
+        return result;
+    }
+
+    // ";B[dd];W[]..." -> danh sách nước, [] là pass
+    std::vector<GameMove> parseMoves(const char* sgf)
+    {
+        std::vector<GameMove> moves;
+        std::string s(sgf);
+        size_t pos = 0;
+        while((pos = s.find(';', pos)) != std::string::npos)
+        {
+            bool isBlack = s[pos + 1] == 'B';
+            size_t open = s.find('[', pos);
+            size_t close = s.find(']', open);
+            if(close == open + 3) moves.push_back({isBlack, s[open + 1] - 'a', s[open + 2] - 'a'});
+            else moves.push_back({isBlack, -1, -1});
+            pos = close;
+        }
+        return moves;
+    }
+
+    MoveResult play(GameLogic& logic, const GameMove& m)
+    {
+        return m.x < 0 ? logic.attemptPass() : logic.attemptMove(m.x, m.y);
+    }
+
+    std::string jsonEscape(const std::string& s)
+    {
+        std::string out;
+        for(char c : s)
+        {
+            if(c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+
+    void benchmarkGame(int size, const char* sgf, const std::string& filter, std::vector<BenchResult>& results)
+    {
+        const std::vector<GameMove> moves = parseMoves(sgf);
+        auto wanted = [&](const std::string& name) { return filter.empty() || (name + "/" + std::to_string(size)).find(filter) != std::string::npos; };
+
+        // Thế cờ cuối ván, và thế cờ ngay trước mỗi nước có bắt quân
+        GameLogic finalPosition(size);
+        finalPosition.newGame();
+        std::vector<GameLogic> beforeCapture;
+        std::vector<GameMove> captureMoves;
+        for(const GameMove& m : moves)
+        {
+            GameLogic before = finalPosition;
+            MoveResult r = play(finalPosition, m);
+            if(!r.success)
+            {
+                std::fprintf(stderr, "Illegal move in %dx%d benchmark game\n", size, size);
+                return;
+            }
+            if(!r.capturedStones.empty())
+            {
+                beforeCapture.push_back(before);
+                captureMoves.push_back(m);
+            }
+        }
+
+        if(wanted("attemptMove"))
+        {
+            GameLogic logic(size);
+            results.push_back(runBenchmark("attemptMove", "replay whole game from an empty board", size, [&]()
+            {
+                logic.newGame();
+                for(const GameMove& m : moves) g_sink += play(logic, m).success;
+                return (long long)moves.size();
+            }));
+        }
+
+        // checkAndRemoveCaptures là hàm private: đo qua attemptMove trên đúng các nước có bắt quân, rồi undo để lặp lại
+        if(wanted("checkAndRemoveCaptures") && !captureMoves.empty())
+        {
+            results.push_back(runBenchmark("checkAndRemoveCaptures", "attemptMove + undo on capturing moves", size, [&]()
+            {
+                for(size_t i = 0; i < captureMoves.size(); ++i)
+                {
+                    g_sink += beforeCapture[i].attemptMove(captureMoves[i].x, captureMoves[i].y).capturedStones.size();
+                    beforeCapture[i].undo();
+                }
+                return (long long)captureMoves.size();
+            }));
+        }
+
+        if(wanted("getTerritoryRegions"))
+        {
+            results.push_back(runBenchmark("getTerritoryRegions", "final position, no dead stones", size, [&]()
+            {
+                g_sink += finalPosition.getTerritoryRegions({}).size();
+                return 1LL;
+            }));
+        }
+
+        if(wanted("calculateScore"))
+        {
+            results.push_back(runBenchmark("calculateScore", "final position, no dead stones", size, [&]()
+            {
+                g_sink += (long long)finalPosition.calculateScore({}, 6.5f).blackTerritory;
+                return 1LL;
+            }));
+        }
+
+        if(wanted("undoRedo"))
+        {
+            GameLogic logic = finalPosition;
+            results.push_back(runBenchmark("undoRedo", "undo to the start then redo to the end, per step", size, [&]()
+            {
+                long long steps = 0;
+                while(logic.canUndo())
+                {
+                    logic.undo();
+                    steps++;
+                }
+                while(logic.canRedo())
+                {
+                    logic.redo();
+                    steps++;
+                }
+                return steps;
+            }));
+        }
+
+        if(wanted("saveLoad"))
+        {
+            std::string path = (std::filesystem::temp_directory_path() / ("gocore_bench_" + std::to_string(size) + ".txt")).string();
+            GameLogic logic = finalPosition;
+            SaveInfo info;
+            info.userTitle = "bench";
+            info.boardSize = size;
+            info.modeStr = "PvP";
+
+            results.push_back(runBenchmark("saveLoad", "saveToFile + loadFromFile of the final position", size, [&]()
+            {
+                float timeBlack = 0.f;
+                float timeWhite = 0.f;
+                std::string mode;
+                std::string reason;
+                int difficulty = 0;
+                g_sink += logic.saveToFile(path, info, 10.f, 10.f, 1);
+                g_sink += logic.loadFromFile(path, timeBlack, timeWhite, mode, difficulty, reason);
+                return 1LL;
+            }));
+
+            std::remove(path.c_str());
+        }
+    }
+
+    void writeJson(std::ostream& out, const std::vector<BenchResult>& results, const char* exe)
+    {
+        std::time_t now = std::time(nullptr);
+        char date[64];
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+        out << "{\n  \"context\": {\n"
+            << "    \"date\": \"" << date << "\",\n"
+            << "    \"executable\": \"" << jsonEscape(exe) << "\",\n"
+            << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+#ifdef NDEBUG
+            << "    \"library_build_type\": \"release\",\n"
+#else
+            << "    \"library_build_type\": \"debug\",\n"
+#endif
+            << "    \"compiler\": \"" << jsonEscape(__VERSION__) << "\"\n"
+            << "  },\n  \"benchmarks\": [\n";
+
+        for(size_t i = 0; i < results.size(); ++i)
+        {
+            const BenchResult& r = results[i];
+            out << "    {\n"
+                << "      \"name\": \"" << r.name << "\",\n"
+                << "      \"run_name\": \"" << r.name << "\",\n"
+                << "      \"run_type\": \"aggregate\",\n"
+                << "      \"aggregate_name\": \"median\",\n"
+                << "      \"repetitions\": " << REPETITIONS << ",\n"
+                << "      \"iterations\": " << r.iterations << ",\n"
+                << "      \"real_time\": " << r.realNs << ",\n"
+                << "      \"cpu_time\": " << r.cpuNs << ",\n"
+                << "      \"time_unit\": \"ns\",\n"
+                << "      \"min_time\": " << r.minNs << ",\n"
+                << "      \"max_time\": " << r.maxNs << ",\n"
+                << "      \"board_size\": " << r.boardSize << ",\n"
+                << "      \"label\": \"" << jsonEscape(r.label) << "\"\n"
+                << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string outPath;
+    std::string filter;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if(arg == "--out" && i + 1 < argc) outPath = argv[++i];
+        else if(arg == "--filter" && i + 1 < argc) filter = argv[++i];
+        else if(arg == "--min-time" && i + 1 < argc) g_minTimeSeconds = std::atof(argv[++i]);
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--out results.json] [--filter name] [--min-time seconds]\n"
+                      << "  JSON goes to stdout unless --out is given; a readable summary goes to stderr.\n";
+            return arg == "-h" || arg == "--help" ? 0 : 1;
+        }
+    }
+
+    std::vector<BenchResult> results;
+    benchmarkGame(9, BenchGames::GAME_9, filter, results);
+    benchmarkGame(13, BenchGames::GAME_13, filter, results);
+    benchmarkGame(19, BenchGames::GAME_19, filter, results);
+
+    if(outPath.empty())
+    {
+        writeJson(std::cout, results, argv[0]);
+    }
+    else
+    {
+        std::ofstream file(outPath);
+        if(!file)
+        {
+            std::cerr << "Cannot write " << outPath << "\n";
+            return 1;
+        }
+        writeJson(file, results, argv[0]);
+    }
+    return 0;
+}
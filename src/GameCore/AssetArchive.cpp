@@ -0,0 +1,290 @@
+#include "AssetArchive.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const char MAGIC[4] = {'G', 'O', 'P', 'K'};
+    const uint32_t VERSION = 1;
+    const size_t HEADER_SIZE = 16;        // magic, version, số file, kích thước bảng đường dẫn
+    const size_t INDEX_ENTRY_SIZE = 32;   // hash, offset, size (u64) + vị trí, độ dài đường dẫn (u32)
+    const size_t DATA_ALIGNMENT = 16;
+
+    // Số nguyên trong file luôn là little-endian
+    uint32_t readU32(const unsigned char* p)
+    {
+        return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+
+    uint64_t readU64(const unsigned char* p)
+    {
+        return (uint64_t)readU32(p) | ((uint64_t)readU32(p + 4) << 32);
+    }
+
+    void writeU32(std::string& out, uint32_t v)
+    {
+        for(int i = 0; i < 4; ++i) out += (char)((v >> (i * 8)) & 0xFF);
+    }
+
+    void writeU64(std::string& out, uint64_t v)
+    {
+        writeU32(out, (uint32_t)v);
+        writeU32(out, (uint32_t)(v >> 32));
+    }
+}
+
+AssetArchive::~AssetArchive()
+{
+    close();
+}
+
+std::string AssetArchive::normalizePath(const std::string& path)
+{
+    std::string result = path;
+    std::replace(result.begin(), result.end(), '\\', '/');
+    while(result.compare(0, 2, "./") == 0) result.erase(0, 2);
+    return result;
+}
+
+uint64_t AssetArchive::hashPath(const std::string& path)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for(char c : normalizePath(path))
+    {
+        hash ^= (unsigned char)c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool AssetArchive::open(const std::string& path)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if(file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < (LONGLONG)HEADER_SIZE)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if(!view)
+    {
+        if(mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_file = file;
+    m_mapping = mapping;
+    m_data = (const unsigned char*)view;
+    m_size = (size_t)fileSize.QuadPart;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+
+    struct stat info;
+    if(fstat(fd, &info) != 0 || info.st_size < (off_t)HEADER_SIZE)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if(view == MAP_FAILED) return false;
+
+    // Lúc khởi động gần như đọc hết archive, báo kernel đọc trước
+    madvise(view, (size_t)info.st_size, MADV_WILLNEED);
+
+    m_data = (const unsigned char*)view;
+    m_size = (size_t)info.st_size;
+#endif
+
+    // Kiểm tra header và mọi mục của bảng chỉ mục nằm trong file
+    bool valid = std::equal(MAGIC, MAGIC + 4, m_data) && readU32(m_data + 4) == VERSION;
+    if(valid)
+    {
+        m_entryCount = readU32(m_data + 8);
+        size_t pathTableSize = readU32(m_data + 12);
+        size_t pathTableStart = HEADER_SIZE + m_entryCount * INDEX_ENTRY_SIZE;
+        valid = pathTableStart + pathTableSize <= m_size;
+
+        for(size_t i = 0; valid && i < m_entryCount; ++i)
+        {
+            IndexEntry entry = entryAt(i);
+            valid = entry.offset <= m_size && entry.size <= m_size - entry.offset
+                    && (size_t)entry.pathOffset + entry.pathLength <= pathTableSize
+                    && (i == 0 || entryAt(i - 1).hash <= entry.hash);
+        }
+    }
+
+    if(!valid)
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void AssetArchive::close()
+{
+    if(!m_data) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+    CloseHandle((HANDLE)m_mapping);
+    CloseHandle((HANDLE)m_file);
+    m_mapping = nullptr;
+    m_file = nullptr;
+#else
+    munmap((void*)m_data, m_size);
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+    m_entryCount = 0;
+}
+
+AssetArchive::IndexEntry AssetArchive::entryAt(size_t index) const
+{
+    const unsigned char* p = m_data + HEADER_SIZE + index * INDEX_ENTRY_SIZE;
+
+    IndexEntry entry;
+    entry.hash = readU64(p);
+    entry.offset = readU64(p + 8);
+    entry.size = readU64(p + 16);
+    entry.pathOffset = readU32(p + 24);
+    entry.pathLength = readU32(p + 28);
+    return entry;
+}
+
+bool AssetArchive::find(const std::string& path, Blob& out) const
+{
+    if(!m_data) return false;
+
+    std::string normalized = normalizePath(path);
+    uint64_t hash = hashPath(normalized);
+    const unsigned char* pathTable = m_data + HEADER_SIZE + m_entryCount * INDEX_ENTRY_SIZE;
+
+    // Tìm nhị phân mục đầu tiên có hash >= hash cần tìm, rồi so đường dẫn để loại trùng hash
+    size_t low = 0;
+    size_t high = m_entryCount;
+    while(low < high)
+    {
+        size_t mid = (low + high) / 2;
+        if(entryAt(mid).hash < hash) low = mid + 1;
+        else high = mid;
+    }
+
+    for(size_t i = low; i < m_entryCount; ++i)
+    {
+        IndexEntry entry = entryAt(i);
+        if(entry.hash != hash) break;
+
+        if(normalized.compare(0, std::string::npos, (const char*)pathTable + entry.pathOffset, entry.pathLength) == 0)
+        {
+            out.data = m_data + entry.offset;
+            out.size = (size_t)entry.size;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AssetArchive::write(const std::string& outPath, const std::vector<std::string>& files, std::string& error)
+{
+    struct PendingFile
+    {
+        std::string path;
+        std::string contents;
+        uint64_t hash;
+    };
+
+    std::vector<PendingFile> pending;
+    for(const std::string& file : files)
+    {
+        std::ifstream in(file, std::ios::binary);
+        if(!in)
+        {
+            error = "cannot read " + file;
+            return false;
+        }
+
+        PendingFile entry;
+        entry.path = normalizePath(file);
+        entry.contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        entry.hash = hashPath(entry.path);
+        pending.push_back(std::move(entry));
+    }
+
+    std::sort(pending.begin(), pending.end(), [](const PendingFile& a, const PendingFile& b)
+    {
+        return a.hash != b.hash ? a.hash < b.hash : a.path < b.path;
+    });
+
+    std::string pathTable;
+    for(const PendingFile& entry : pending) pathTable += entry.path;
+
+    size_t dataStart = HEADER_SIZE + pending.size() * INDEX_ENTRY_SIZE + pathTable.size();
+    dataStart = (dataStart + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+
+    std::string header(MAGIC, 4);
+    writeU32(header, VERSION);
+    writeU32(header, (uint32_t)pending.size());
+    writeU32(header, (uint32_t)pathTable.size());
+
+    std::string index;
+    uint64_t offset = dataStart;
+    uint32_t pathOffset = 0;
+    for(const PendingFile& entry : pending)
+    {
+        writeU64(index, entry.hash);
+        writeU64(index, offset);
+        writeU64(index, entry.contents.size());
+        writeU32(index, pathOffset);
+        writeU32(index, (uint32_t)entry.path.size());
+
+        pathOffset += (uint32_t)entry.path.size();
+        offset += (entry.contents.size() + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+    }
+
+    std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+    if(!out)
+    {
+        error = "cannot write " + outPath;
+        return false;
+    }
+
+    out << header << index << pathTable;
+    out << std::string(dataStart - (header.size() + index.size() + pathTable.size()), '\0');
+    for(const PendingFile& entry : pending)
+    {
+        out << entry.contents;
+        size_t padding = (DATA_ALIGNMENT - entry.contents.size() % DATA_ALIGNMENT) % DATA_ALIGNMENT;
+        out << std::string(padding, '\0');
+    }
+
+    if(!out)
+    {
+        error = "write failed for " + outPath;
+        return false;
+    }
+    return true;
+}
@@ -1,4 +1,5 @@
 #include "Game.h"
+#include "LoadingScreen.h"
 #include "MainMenu.h"
 #include "NewGame.h"
 #include "SizeSelection.h"
@@ -26,7 +27,8 @@ Game::Game(unsigned int width, unsigned int height, const std::string& title) :
     m_dimOverlay.setSize(sf::Vector2f((float)width, (float)height));
     m_dimOverlay.setFillColor(sf::Color(0, 0, 0, 150));
 
-    m_currentState = createState(GameStateType::MainMenu);
+    // Tài nguyên còn đang giải mã nền, LoadingScreen chuyển sang MainMenu khi xong
+    m_currentState = createState(GameStateType::Loading);
 
     sf::VideoMode desktop = sf::VideoMode::getDesktopMode();
     int centerX = (int)(desktop.width - width) / 2;
@@ -303,6 +305,8 @@ std::unique_ptr<GameState> Game::createState(GameStateType state)
 {
     switch(state)
     {
+        case GameStateType::Loading:
+            return std::make_unique<LoadingScreen>(m_window);
         case GameStateType::MainMenu:
             return std::make_unique<MainMenu>(m_window);
         case GameStateType::NewGame:
@@ -6,65 +6,130 @@
 #include <queue>
 #include <sstream>
 
-const int DX[] = {0, 0, 1, -1};
-const int DY[] = {1, -1, 0, 0};
+namespace
+{
+    uint64_t splitMix64(uint64_t& state)
+    {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+}
 
 GameLogic::GameLogic(int size) : m_boardSize(size)
 {
-    m_board.resize(m_boardSize, std::vector<StoneType>(m_boardSize, StoneType::Empty));
-    m_previousBoard.resize(m_boardSize, std::vector<StoneType>(m_boardSize, StoneType::Empty));
+    resizeBoard(size);
     newGame();
 }
 
-void GameLogic::newGame()
+void GameLogic::resizeBoard(int size)
 {
-    for(auto& row : m_board)
-        std::fill(row.begin(), row.end(), StoneType::Empty);
+    m_boardSize = size;
+    m_stride = size + 2;
+
+    m_neighborOffset[0] = m_stride;
+    m_neighborOffset[1] = -m_stride;
+    m_neighborOffset[2] = 1;
+    m_neighborOffset[3] = -1;
+
+    m_board.assign(m_stride * m_stride, CELL_BORDER);
+    m_groupHead.assign(m_board.size(), -1);
+    m_nextStone.assign(m_board.size(), -1);
+    m_groupSize.assign(m_board.size(), 0);
+    m_groupLibs.assign(m_board.size(), 0);
+    m_libMark.assign(m_board.size(), 0);
+    m_libMarkStamp = 0;
+
+    // Seed cố định theo kích thước bàn để hash ổn định giữa các lần chạy
+    uint64_t seed = 0x5A0B15ULL + (uint64_t)size;
+    m_zobrist.resize(m_board.size() * 2);
+    for(auto& key : m_zobrist)
+    {
+        key = splitMix64(seed);
+    }
+    m_hash = 0;
+
+    for(int y = 0; y < m_boardSize; ++y)
+    {
+        for(int x = 0; x < m_boardSize; ++x)
+        {
+            m_board[toIndex(x, y)] = CELL_EMPTY;
+        }
+    }
+}
 
-    for(auto& row : m_previousBoard)
-        std::fill(row.begin(), row.end(), StoneType::Empty);
+void GameLogic::newGame()
+{
+    for(auto& cell : m_board)
+    {
+        if(cell != CELL_BORDER) cell = CELL_EMPTY;
+    }
+    std::fill(m_groupHead.begin(), m_groupHead.end(), -1);
+    m_hash = 0;
 
     m_isBlacksTurn = true;
     m_koPosition = {-1, -1};
     m_lastPlayerPassed = false;
 
-    while(!m_undoStack.empty()) m_undoStack.pop();
+    m_undoStack.clear();
     while(!m_redoStack.empty()) m_redoStack.pop();
+    m_setupStones.clear();
+
+    resetPositionHistory();
+}
+
+void GameLogic::resetPositionHistory()
+{
+    m_seenPositions.clear();
+    m_seenPositions[m_hash] = 1;
+}
+
+std::vector<std::vector<StoneType>> GameLogic::getBoard() const
+{
+    std::vector<std::vector<StoneType>> board(m_boardSize, std::vector<StoneType>(m_boardSize, StoneType::Empty));
+    for(int y = 0; y < m_boardSize; ++y)
+    {
+        const uint8_t* row = &m_board[toIndex(0, y)];
+        for(int x = 0; x < m_boardSize; ++x)
+        {
+            board[y][x] = static_cast<StoneType>(row[x]);
+        }
+    }
+    return board;
 }
 
-std::vector<TerritoryRegion> GameLogic::getTerritoryRegions(const std::vector<sf::Vector2i>& deadStones) const
+std::vector<TerritoryRegion> GameLogic::getTerritoryRegions(const std::vector<BoardPoint>& deadStones) const
 {
     std::vector<TerritoryRegion> regions;
-    std::vector<std::vector<bool>> visited(m_boardSize, std::vector<bool>(m_boardSize, false));
 
-    std::vector<std::vector<bool>> deadMap(m_boardSize, std::vector<bool>(m_boardSize, false));
+    // Bản sao phẳng, đá chết được coi như ô trống
+    std::vector<uint8_t> cells = m_board;
+    std::vector<bool> visited(cells.size(), false);
 
     for(const auto& p : deadStones)
     {
         if(p.x >= 0 && p.x < m_boardSize && p.y >= 0 && p.y < m_boardSize)
         {
-            deadMap[p.y][p.x] = true;
+            cells[toIndex(p.x, p.y)] = CELL_EMPTY;
         }
     }
 
-    auto getEffectiveType = [&](int x, int y) -> StoneType
-    {
-        if(deadMap[y][x]) return StoneType::Empty;
-        return m_board[y][x];
-    };
+    std::vector<int> q;
+    q.reserve(m_boardSize * m_boardSize);
 
     for(int y = 0; y < m_boardSize; ++y)
     {
         for(int x = 0; x < m_boardSize; ++x)
         {
-            if(getEffectiveType(x, y) == StoneType::Empty && !visited[y][x])
+            int start = toIndex(x, y);
+            if(cells[start] == CELL_EMPTY && !visited[start])
             {
                 TerritoryRegion region;
-                std::vector<sf::Vector2i> q;
-                q.reserve(m_boardSize * m_boardSize);
-                q.push_back({x, y});
+                q.clear();
+                q.push_back(start);
 
-                visited[y][x] = true;
+                visited[start] = true;
 
                 bool touchBlack = false;
                 bool touchWhite = false;
@@ -72,32 +137,28 @@ std::vector<TerritoryRegion> GameLogic::getTerritoryRegions(const std::vector<sf
 
                 while(head < (int)q.size())
                 {
-                    sf::Vector2i curr = q[head++];
-                    region.points.push_back(curr);
+                    int curr = q[head++];
+                    region.points.push_back({indexX(curr), indexY(curr)});
 
                     for(int i = 0; i < 4; ++i)
                     {
-                        int nx = curr.x + DX[i];
-                        int ny = curr.y + DY[i];
-
-                        if(nx < 0 || nx >= m_boardSize || ny < 0 || ny >= m_boardSize) continue;
+                        int n = curr + m_neighborOffset[i];
+                        uint8_t neighborType = cells[n];
 
-                        StoneType neighborType = getEffectiveType(nx, ny);
-
-                        if(neighborType == StoneType::Black)
+                        if(neighborType == CELL_BLACK)
                         {
                             touchBlack = true;
-                            region.boundaries.push_back({nx, ny});
+                            region.boundaries.push_back({indexX(n), indexY(n)});
                         }
-                        else if(neighborType == StoneType::White)
+                        else if(neighborType == CELL_WHITE)
                         {
                             touchWhite = true;
-                            region.boundaries.push_back({nx, ny});
+                            region.boundaries.push_back({indexX(n), indexY(n)});
                         }
-                        else if(neighborType == StoneType::Empty && !visited[ny][nx])
+                        else if(neighborType == CELL_EMPTY && !visited[n])
                         {
-                            visited[ny][nx] = true;
-                            q.push_back({nx, ny});
+                            visited[n] = true;
+                            q.push_back(n);
                         }
                     }
                 }
@@ -117,18 +178,15 @@ GameLogic::StoneCount GameLogic::getStoneCount() const
 {
     StoneCount counts;
 
-    for(int y = 0; y < m_boardSize; ++y)
+    for(uint8_t cell : m_board)
     {
-        for(int x = 0; x < m_boardSize; ++x)
+        if(cell == CELL_BLACK)
         {
-            if(m_board[y][x] == StoneType::Black)
-            {
-                counts.blackStones++;
-            }
-            else if(m_board[y][x] == StoneType::White)
-            {
-                counts.whiteStones++;
-            }
+            counts.blackStones++;
+        }
+        else if(cell == CELL_WHITE)
+        {
+            counts.whiteStones++;
         }
     }
     return counts;
@@ -139,31 +197,28 @@ ScoreData GameLogic::calculateScore(const std::vector<DeadStoneInfo>& deadStones
     ScoreData data;
     data.komi = komi;
 
-    std::vector<std::vector<bool>> isDead(m_boardSize, std::vector<bool>(m_boardSize, false));
+    std::vector<bool> isDead(m_board.size(), false);
     for(const auto& ds : deadStones)
     {
         if(ds.pos.x >= 0 && ds.pos.x < m_boardSize && ds.pos.y >= 0 && ds.pos.y < m_boardSize)
         {
-            isDead[ds.pos.y][ds.pos.x] = true;
+            isDead[toIndex(ds.pos.x, ds.pos.y)] = true;
         }
     }
 
-    for(int y = 0; y < m_boardSize; ++y)
+    for(size_t i = 0; i < m_board.size(); ++i)
     {
-        for(int x = 0; x < m_boardSize; ++x)
+        if(m_board[i] == CELL_BLACK && !isDead[i])
         {
-            if(m_board[y][x] == StoneType::Black && !isDead[y][x])
-            {
-                data.blackStones++;
-            }
-            else if(m_board[y][x] == StoneType::White && !isDead[y][x])
-            {
-                data.whiteStones++;
-            }
+            data.blackStones++;
+        }
+        else if(m_board[i] == CELL_WHITE && !isDead[i])
+        {
+            data.whiteStones++;
         }
     }
 
-    std::vector<sf::Vector2i> simpleDeadStones;
+    std::vector<BoardPoint> simpleDeadStones;
     for(const auto& ds : deadStones)
     {
         simpleDeadStones.push_back(ds.pos);
@@ -189,7 +244,7 @@ ScoreData GameLogic::calculateScore(const std::vector<DeadStoneInfo>& deadStones
 StoneType GameLogic::getStoneAt(int x, int y) const
 {
     if(x >= 0 && x < m_boardSize && y >= 0 && y < m_boardSize)
-        return m_board[y][x];
+        return static_cast<StoneType>(m_board[toIndex(x, y)]);
     return StoneType::Empty;
 }
 
@@ -204,7 +259,7 @@ MoveResult GameLogic::attemptPass()
     result.success = true;
     result.capturedStones.clear();
 
-    m_undoStack.push(createSnapshot());
+    m_undoStack.push_back(createRecord(-1));
     while(!m_redoStack.empty()) m_redoStack.pop();
 
     if(m_lastPlayerPassed)
@@ -218,8 +273,7 @@ MoveResult GameLogic::attemptPass()
         result.gameEnded = false;
     }
 
-    m_lastPlayerPassed = true;
-    m_isBlacksTurn = !m_isBlacksTurn;
+    applyPass();
 
     return result;
 }
@@ -235,13 +289,15 @@ MoveResult GameLogic::attemptMove(int x, int y)
         result.message = "Invalid: Out of bounds.";
         return result;
     }
-    if(m_board[y][x] != StoneType::Empty)
+
+    int idx = toIndex(x, y);
+    if(m_board[idx] != CELL_EMPTY)
     {
         result.message = "Invalid: Spot occupied.";
         return result;
     }
 
-    StoneType currentPlayer = m_isBlacksTurn ? StoneType::Black : StoneType::White;
+    uint8_t currentPlayer = m_isBlacksTurn ? CELL_BLACK : CELL_WHITE;
 
     if(isKo(x, y))
     {
@@ -249,72 +305,29 @@ MoveResult GameLogic::attemptMove(int x, int y)
         return result;
     }
 
-    m_board[y][x] = currentPlayer;
-
-    bool willCapture = false;
-    StoneType opponent = (currentPlayer == StoneType::Black) ? StoneType::White : StoneType::Black;
-
-    for(int i = 0; i < 4; ++i)
+    if(isSuicide(idx, currentPlayer))
     {
-        int nx = x + DX[i];
-        int ny = y + DY[i];
-
-        if(nx >= 0 && nx < m_boardSize && ny >= 0 && ny < m_boardSize)
-        {
-            if(m_board[ny][nx] == opponent)
-            {
-                std::vector<std::vector<bool>> vStones(m_boardSize, std::vector<bool>(m_boardSize, false));
-                std::vector<std::pair<int, int>> group;
-                std::vector<std::vector<bool>> vLibs(m_boardSize, std::vector<bool>(m_boardSize, false));
-
-                if(findGroupLiberties(nx, ny, opponent, vStones, group, vLibs) == 0)
-                {
-                    willCapture = true;
-                    break;
-                }
-            }
-        }
+        result.message = "Invalid: Suicide.";
+        return result;
     }
 
-    if(!willCapture && isSuicide(x, y, currentPlayer))
+    if(m_superko && m_seenPositions.count(hashAfterMove(idx, currentPlayer)) > 0)
     {
-        m_board[y][x] = StoneType::Empty;
-        result.message = "Invalid: Suicide.";
+        result.message = "Invalid: Superko violation.";
         return result;
     }
 
-    m_board[y][x] = StoneType::Empty;
-    m_undoStack.push(createSnapshot());
-    while(!m_redoStack.empty()) m_redoStack.pop();
-
-    m_board[y][x] = currentPlayer;
-
-    result.capturedStones = checkAndRemoveCaptures(x, y, currentPlayer);
+    MoveRecord record = createRecord(idx);
+    applyMove(idx, currentPlayer, record.captured);
 
-    if(result.capturedStones.size() == 1)
+    for(int c : record.captured)
     {
-        std::vector<std::vector<bool>> visitedStones(m_boardSize, std::vector<bool>(m_boardSize, false));
-        std::vector<std::pair<int, int>> group;
-        std::vector<std::vector<bool>> visitedLibs(m_boardSize, std::vector<bool>(m_boardSize, false));
-
-        int myLiberties = findGroupLiberties(x, y, currentPlayer, visitedStones, group, visitedLibs);
-
-        if(myLiberties == 1)
-        {
-            m_koPosition = result.capturedStones[0];
-        }
-        else
-        {
-            m_koPosition = {-1, -1};
-        }
-    }
-    else
-    {
-        m_koPosition = {-1, -1};
+        result.capturedStones.push_back({indexX(c), indexY(c)});
     }
 
-    m_lastPlayerPassed = false;
-    m_isBlacksTurn = !m_isBlacksTurn;
+    m_undoStack.push_back(std::move(record));
+    while(!m_redoStack.empty()) m_redoStack.pop();
+
     result.success = true;
     result.message = "OK";
 
@@ -325,22 +338,46 @@ void GameLogic::undo()
 {
     if(m_undoStack.empty()) return;
 
-    m_redoStack.push(createSnapshot());
+    MoveRecord record = std::move(m_undoStack.back());
+    m_undoStack.pop_back();
+
+    auto it = m_seenPositions.find(m_hash);
+    if(it != m_seenPositions.end() && --it->second == 0) m_seenPositions.erase(it);
 
-    GameStateSnapshot prev = m_undoStack.top();
-    m_undoStack.pop();
-    restoreState(prev);
+    revertMove(record);
+    m_redoStack.push(std::move(record));
 }
 
 void GameLogic::redo()
 {
     if(m_redoStack.empty()) return;
 
-    m_undoStack.push(createSnapshot());
-
-    GameStateSnapshot next = m_redoStack.top();
+    MoveRecord record = std::move(m_redoStack.top());
     m_redoStack.pop();
-    restoreState(next);
+
+    if(record.index < 0)
+    {
+        applyPass();
+    }
+    else
+    {
+        record.captured.clear();
+        applyMove(record.index, record.isBlack ? CELL_BLACK : CELL_WHITE, record.captured);
+    }
+    m_undoStack.push_back(std::move(record));
+}
+
+std::vector<GameMove> GameLogic::getMoveHistory() const
+{
+    std::vector<GameMove> moves(m_setupStones);
+    moves.reserve(m_setupStones.size() + m_undoStack.size());
+
+    for(const MoveRecord& record : m_undoStack)
+    {
+        if(record.index < 0) moves.push_back({record.isBlack, -1, -1});
+        else moves.push_back({record.isBlack, indexX(record.index), indexY(record.index)});
+    }
+    return moves;
 }
 
 bool GameLogic::canUndo() const
@@ -352,110 +389,376 @@ bool GameLogic::canRedo() const
     return !m_redoStack.empty();
 }
 
-GameStateSnapshot GameLogic::createSnapshot() const
+MoveRecord GameLogic::createRecord(int idx) const
 {
-    GameStateSnapshot snap;
-    snap.board = m_board;
-    snap.isBlacksTurn = m_isBlacksTurn;
-    snap.koPosition = m_koPosition;
-    snap.lastPlayerPassed = m_lastPlayerPassed;
-    return snap;
+    MoveRecord record;
+    record.index = idx;
+    record.isBlack = m_isBlacksTurn;
+    record.koPosition = m_koPosition;
+    record.lastPlayerPassed = m_lastPlayerPassed;
+    return record;
 }
 
-void GameLogic::restoreState(const GameStateSnapshot& state)
+void GameLogic::applyMove(int idx, uint8_t player, std::vector<int>& captured)
 {
-    m_board = state.board;
-    m_isBlacksTurn = state.isBlacksTurn;
-    m_koPosition = state.koPosition;
-    m_lastPlayerPassed = state.lastPlayerPassed;
+    placeStone(idx, player);
+    checkAndRemoveCaptures(idx, player, captured);
+
+    if(captured.size() == 1 && countLiberties(m_groupHead[idx]) == 1)
+    {
+        m_koPosition = {indexX(captured[0]), indexY(captured[0])};
+    }
+    else
+    {
+        m_koPosition = {-1, -1};
+    }
+
+    m_lastPlayerPassed = false;
+    m_isBlacksTurn = (player != CELL_BLACK);
+    m_seenPositions[m_hash]++;
+}
+
+void GameLogic::applyPass()
+{
+    m_lastPlayerPassed = true;
+    m_isBlacksTurn = !m_isBlacksTurn;
+    m_seenPositions[m_hash]++;
+}
+
+void GameLogic::revertMove(const MoveRecord& record)
+{
+    if(record.index >= 0)
+    {
+        uint8_t player = record.isBlack ? CELL_BLACK : CELL_WHITE;
+        uint8_t opponent = record.isBlack ? CELL_WHITE : CELL_BLACK;
+
+        m_hash ^= zobristKey(record.index, player);
+        m_board[record.index] = CELL_EMPTY;
+        m_groupHead[record.index] = -1;
+
+        for(int c : record.captured)
+        {
+            m_board[c] = opponent;
+            m_hash ^= zobristKey(c, opponent);
+        }
+
+        std::vector<int> touched = record.captured;
+        touched.push_back(record.index);
+        repairGroups(touched);
+    }
+
+    m_isBlacksTurn = record.isBlack;
+    m_koPosition = record.koPosition;
+    m_lastPlayerPassed = record.lastPlayerPassed;
 }
 
-std::vector<std::pair<int, int>> GameLogic::checkAndRemoveCaptures(int x, int y, StoneType player)
+void GameLogic::checkAndRemoveCaptures(int idx, uint8_t player, std::vector<int>& captured)
 {
-    std::vector<std::pair<int, int>> allCaptured;
-    StoneType opponent = (player == StoneType::Black) ? StoneType::White : StoneType::Black;
+    uint8_t opponent = (player == CELL_BLACK) ? CELL_WHITE : CELL_BLACK;
 
     for(int i = 0; i < 4; ++i)
     {
-        int nx = x + DX[i];
-        int ny = y + DY[i];
+        int n = idx + m_neighborOffset[i];
 
-        if(nx >= 0 && nx < m_boardSize && ny >= 0 && ny < m_boardSize)
+        if(m_board[n] == opponent && m_groupLibs[m_groupHead[n]] == 0)
         {
-            if(m_board[ny][nx] == opponent)
-            {
-                std::vector<std::vector<bool>> visitedStones(m_boardSize, std::vector<bool>(m_boardSize, false));
-                std::vector<std::pair<int, int>> group;
-                std::vector<std::vector<bool>> visitedLiberties(m_boardSize, std::vector<bool>(m_boardSize, false));
+            removeGroup(m_groupHead[n], captured);
+        }
+    }
+}
+
+void GameLogic::rebuildGroups()
+{
+    std::fill(m_groupHead.begin(), m_groupHead.end(), -1);
+
+    for(int idx = 0; idx < (int)m_board.size(); ++idx)
+    {
+        if((m_board[idx] == CELL_BLACK || m_board[idx] == CELL_WHITE) && m_groupHead[idx] == -1)
+        {
+            buildGroup(idx);
+        }
+    }
+}
 
-                int libs = findGroupLiberties(nx, ny, opponent, visitedStones, group, visitedLiberties);
-                if(libs == 0)
+void GameLogic::repairGroups(const std::vector<int>& points)
+{
+    // Chỉ dựng lại các chuỗi chạm vào những ô vừa đổi trạng thái
+    std::vector<int> seeds;
+    for(int p : points)
+    {
+        if(m_board[p] == CELL_BLACK || m_board[p] == CELL_WHITE) seeds.push_back(p);
+        for(int i = 0; i < 4; ++i)
+        {
+            int n = p + m_neighborOffset[i];
+            if(m_board[n] == CELL_BLACK || m_board[n] == CELL_WHITE) seeds.push_back(n);
+        }
+    }
+
+    // Xóa gốc cũ của toàn bộ chuỗi liên thông với các hạt giống
+    m_libMarkStamp++;
+    std::vector<int> stack;
+    for(int seed : seeds)
+    {
+        if(m_libMark[seed] == m_libMarkStamp) continue;
+        m_libMark[seed] = m_libMarkStamp;
+        stack.push_back(seed);
+
+        while(!stack.empty())
+        {
+            int curr = stack.back();
+            stack.pop_back();
+            m_groupHead[curr] = -1;
+
+            for(int i = 0; i < 4; ++i)
+            {
+                int n = curr + m_neighborOffset[i];
+                if(m_board[n] == m_board[curr] && m_libMark[n] != m_libMarkStamp)
                 {
-                    removeGroup(group);
-                    allCaptured.insert(allCaptured.end(), group.begin(), group.end());
+                    m_libMark[n] = m_libMarkStamp;
+                    stack.push_back(n);
                 }
             }
         }
     }
-    return allCaptured;
+
+    for(int seed : seeds)
+    {
+        if(m_groupHead[seed] == -1) buildGroup(seed);
+    }
 }
 
-int GameLogic::findGroupLiberties(int x, int y, StoneType player,
-                                  std::vector<std::vector<bool>>& visited_stones,
-                                  std::vector<std::pair<int, int>>& group,
-                                  std::vector<std::vector<bool>>& visited_liberties)
+void GameLogic::buildGroup(int idx)
 {
-    if(visited_stones[y][x]) return 0;
+    // Gom chuỗi bằng flood fill, nối thành danh sách vòng
+    uint8_t color = m_board[idx];
+    int head = idx;
+    int tail = idx;
+    int libs = 0;
+    int size = 0;
+
+    std::vector<int> stack;
+    m_groupHead[idx] = head;
+    stack.push_back(idx);
+
+    while(!stack.empty())
+    {
+        int curr = stack.back();
+        stack.pop_back();
+        size++;
 
-    visited_stones[y][x] = true;
-    group.push_back({x, y});
+        m_nextStone[tail] = curr;
+        tail = curr;
 
-    int liberties = 0;
+        for(int i = 0; i < 4; ++i)
+        {
+            int n = curr + m_neighborOffset[i];
+            if(m_board[n] == CELL_EMPTY)
+            {
+                libs++;
+            }
+            else if(m_board[n] == color && m_groupHead[n] == -1)
+            {
+                m_groupHead[n] = head;
+                stack.push_back(n);
+            }
+        }
+    }
+
+    m_nextStone[tail] = head;
+    m_groupSize[head] = size;
+    m_groupLibs[head] = libs;
+}
+
+void GameLogic::placeStone(int idx, uint8_t player)
+{
+    m_board[idx] = player;
+    m_hash ^= zobristKey(idx, player);
+    m_groupHead[idx] = idx;
+    m_nextStone[idx] = idx;
+    m_groupSize[idx] = 1;
+    m_groupLibs[idx] = 0;
 
     for(int i = 0; i < 4; ++i)
     {
-        int nx = x + DX[i];
-        int ny = y + DY[i];
+        int n = idx + m_neighborOffset[i];
+        uint8_t cell = m_board[n];
+
+        if(cell == CELL_EMPTY)
+        {
+            m_groupLibs[idx]++;
+        }
+        else if(cell == CELL_BLACK || cell == CELL_WHITE)
+        {
+            m_groupLibs[m_groupHead[n]]--;
+        }
+    }
+
+    for(int i = 0; i < 4; ++i)
+    {
+        int n = idx + m_neighborOffset[i];
+        if(m_board[n] == player && m_groupHead[n] != m_groupHead[idx])
+        {
+            mergeGroups(m_groupHead[idx], m_groupHead[n]);
+        }
+    }
+}
+
+int GameLogic::mergeGroups(int headA, int headB)
+{
+    // Gộp chuỗi nhỏ vào chuỗi lớn để số ô phải đổi gốc là ít nhất
+    if(m_groupSize[headA] < m_groupSize[headB]) std::swap(headA, headB);
+
+    int s = headB;
+    do
+    {
+        m_groupHead[s] = headA;
+        s = m_nextStone[s];
+    }
+    while(s != headB);
+
+    std::swap(m_nextStone[headA], m_nextStone[headB]);
+    m_groupSize[headA] += m_groupSize[headB];
+    m_groupLibs[headA] += m_groupLibs[headB];
+
+    return headA;
+}
+
+int GameLogic::countLiberties(int head) const
+{
+    // Đếm khí thật (không trùng lặp) bằng dấu thời gian
+    m_libMarkStamp++;
+    int liberties = 0;
 
-        if(nx >= 0 && nx < m_boardSize && ny >= 0 && ny < m_boardSize)
+    int s = head;
+    do
+    {
+        for(int i = 0; i < 4; ++i)
         {
-            if(m_board[ny][nx] == StoneType::Empty)
+            int n = s + m_neighborOffset[i];
+            if(m_board[n] == CELL_EMPTY && m_libMark[n] != m_libMarkStamp)
             {
-                if(!visited_liberties[ny][nx])
-                {
-                    visited_liberties[ny][nx] = true;
-                    liberties++;
-                }
+                m_libMark[n] = m_libMarkStamp;
+                liberties++;
             }
-            else if(m_board[ny][nx] == player)
+        }
+        s = m_nextStone[s];
+    }
+    while(s != head);
+
+    return liberties;
+}
+
+void GameLogic::removeGroup(int head, std::vector<int>& removed)
+{
+    size_t first = removed.size();
+
+    int s = head;
+    do
+    {
+        m_hash ^= zobristKey(s, m_board[s]);
+        m_board[s] = CELL_EMPTY;
+        m_groupHead[s] = -1;
+        removed.push_back(s);
+        s = m_nextStone[s];
+    }
+    while(s != head);
+
+    // Mỗi ô vừa trống trả lại một khí cho các chuỗi kề bên
+    for(size_t k = first; k < removed.size(); ++k)
+    {
+        for(int i = 0; i < 4; ++i)
+        {
+            int n = removed[k] + m_neighborOffset[i];
+            if(m_board[n] == CELL_BLACK || m_board[n] == CELL_WHITE)
             {
-                if(!visited_stones[ny][nx])
-                {
-                    liberties += findGroupLiberties(nx, ny, player, visited_stones, group, visited_liberties);
-                }
+                m_groupLibs[m_groupHead[n]]++;
             }
         }
     }
-    return liberties;
 }
 
-void GameLogic::removeGroup(const std::vector<std::pair<int, int>>& group)
+bool GameLogic::isSuicide(int idx, uint8_t player) const
 {
-    for(const auto& p : group)
+    // Khí giả của chuỗi kề sẽ giảm đúng bằng số cạnh chung với idx
+    int heads[4];
+    int shared[4];
+    int count = 0;
+
+    for(int i = 0; i < 4; ++i)
     {
-        m_board[p.second][p.first] = StoneType::Empty;
+        int n = idx + m_neighborOffset[i];
+        uint8_t cell = m_board[n];
+
+        if(cell == CELL_EMPTY) return false;
+        if(cell == CELL_BORDER) continue;
+
+        int h = m_groupHead[n];
+        int j = 0;
+        while(j < count && heads[j] != h) ++j;
+        if(j == count)
+        {
+            heads[count] = h;
+            shared[count] = 0;
+            count++;
+        }
+        shared[j]++;
+    }
+
+    for(int j = 0; j < count; ++j)
+    {
+        int libsAfter = m_groupLibs[heads[j]] - shared[j];
+        if(m_board[heads[j]] == player)
+        {
+            if(libsAfter > 0) return false;
+        }
+        else if(libsAfter == 0)
+        {
+            return false;
+        }
     }
+    return true;
 }
 
-bool GameLogic::isSuicide(int x, int y, StoneType player)
+uint64_t GameLogic::hashAfterMove(int idx, uint8_t player) const
 {
-    std::vector<std::vector<bool>> visitedStones(m_boardSize, std::vector<bool>(m_boardSize, false));
-    std::vector<std::pair<int, int>> group;
-    std::vector<std::vector<bool>> visitedLiberties(m_boardSize, std::vector<bool>(m_boardSize, false));
+    uint64_t hash = m_hash ^ zobristKey(idx, player);
+    uint8_t opponent = (player == CELL_BLACK) ? CELL_WHITE : CELL_BLACK;
+
+    int heads[4];
+    int shared[4];
+    int count = 0;
+
+    for(int i = 0; i < 4; ++i)
+    {
+        int n = idx + m_neighborOffset[i];
+        if(m_board[n] != opponent) continue;
+
+        int h = m_groupHead[n];
+        int j = 0;
+        while(j < count && heads[j] != h) ++j;
+        if(j == count)
+        {
+            heads[count] = h;
+            shared[count] = 0;
+            count++;
+        }
+        shared[j]++;
+    }
 
-    int libs = findGroupLiberties(x, y, player, visitedStones, group, visitedLiberties);
+    // Các chuỗi đối phương hết khí sau nước đi sẽ bị bắt
+    for(int j = 0; j < count; ++j)
+    {
+        if(m_groupLibs[heads[j]] != shared[j]) continue;
 
-    return (libs == 0);
+        int s = heads[j];
+        do
+        {
+            hash ^= zobristKey(s, opponent);
+            s = m_nextStone[s];
+        }
+        while(s != heads[j]);
+    }
+    return hash;
 }
 
 bool GameLogic::isKo(int x, int y)
@@ -480,13 +783,14 @@ bool GameLogic::saveToFile(const std::string& filePath, const SaveInfo& info, fl
          << (m_lastPlayerPassed ? 1 : 0) << " "
          << timeBlack << " " << timeWhite << "\n";
 
-    for(const auto& row : m_board)
+    for(int y = 0; y < m_boardSize; ++y)
     {
-        for(const auto& stone : row)
+        for(int x = 0; x < m_boardSize; ++x)
         {
+            uint8_t stone = m_board[toIndex(x, y)];
             int val = 0;
-            if(stone == StoneType::Black) val = 1;
-            else if(stone == StoneType::White) val = 2;
+            if(stone == CELL_BLACK) val = 1;
+            else if(stone == CELL_WHITE) val = 2;
             file << val << " ";
         }
         file << "\n";
@@ -556,9 +860,7 @@ bool GameLogic::loadFromFile(const std::string& filePath, float& timeBlack, floa
 
     if(size != m_boardSize)
     {
-        m_boardSize = size;
-        m_board.assign(size, std::vector<StoneType>(size, StoneType::Empty));
-        m_previousBoard.assign(size, std::vector<StoneType>(size, StoneType::Empty));
+        resizeBoard(size);
     }
 
     m_isBlacksTurn = (turn == 1);
@@ -571,14 +873,38 @@ bool GameLogic::loadFromFile(const std::string& filePath, float& timeBlack, floa
         {
             int val;
             file >> val;
-            if(val == 1) m_board[y][x] = StoneType::Black;
-            else if(val == 2) m_board[y][x] = StoneType::White;
-            else m_board[y][x] = StoneType::Empty;
+            int idx = toIndex(x, y);
+            if(val == 1) m_board[idx] = CELL_BLACK;
+            else if(val == 2) m_board[idx] = CELL_WHITE;
+            else m_board[idx] = CELL_EMPTY;
+        }
+    }
+
+    rebuildGroups();
+
+    m_hash = 0;
+    for(int idx = 0; idx < (int)m_board.size(); ++idx)
+    {
+        if(m_board[idx] == CELL_BLACK || m_board[idx] == CELL_WHITE)
+        {
+            m_hash ^= zobristKey(idx, m_board[idx]);
         }
     }
 
-    while(!m_undoStack.empty()) m_undoStack.pop();
+    m_setupStones.clear();
+    for(int y = 0; y < m_boardSize; ++y)
+    {
+        for(int x = 0; x < m_boardSize; ++x)
+        {
+            uint8_t cell = m_board[toIndex(x, y)];
+            if(cell != CELL_EMPTY) m_setupStones.push_back({cell == CELL_BLACK, x, y});
+        }
+    }
+
+    m_undoStack.clear();
     while(!m_redoStack.empty()) m_redoStack.pop();
 
+    resetPositionHistory();
+
     return true;
 }
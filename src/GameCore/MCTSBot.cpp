@@ -0,0 +1,751 @@
+#include "MCTSBot.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+
+namespace
+{
+    // Hằng số cân bằng RAVE/UCT (Gelly & Silver) và hệ số khám phá nhỏ vì RAVE đã định hướng sẵn
+    const float RAVE_EQUIVALENCE = 3000.0f;
+    const float EXPLORATION = 0.1f;
+    const float FIRST_PLAY_URGENCY = 1.1f;
+
+    // Nước pass được gán sẵn 10 lượt thua để không bị chọn sớm khi bàn còn rộng
+    const float PASS_PRIOR_VISITS = 10.0f;
+
+    // Ponder tối đa bằng ngần này lần thời gian mỗi nước, tránh chạy mãi khi người chơi bỏ đi
+    const int PONDER_TIME_FACTOR = 10;
+
+    const float RESIGN_THRESHOLD = 0.05f;
+    const int DEAD_STONE_PLAYOUTS = 500;
+}
+
+// ================= PlayoutBoard =================
+
+void PlayoutBoard::reset(int boardSize)
+{
+    size = boardSize;
+    stride = size + 2;
+
+    offsets[0] = -stride;
+    offsets[1] = stride;
+    offsets[2] = -1;
+    offsets[3] = 1;
+
+    diagonals[0] = -stride - 1;
+    diagonals[1] = -stride + 1;
+    diagonals[2] = stride - 1;
+    diagonals[3] = stride + 1;
+
+    std::memset(cell, BORDER, sizeof(cell));
+    emptyCount = 0;
+
+    for(int y = 0; y < size; ++y)
+    {
+        for(int x = 0; x < size; ++x)
+        {
+            int idx = toIndex(x, y);
+            cell[idx] = EMPTY;
+            head[idx] = -1;
+            addEmpty(idx);
+        }
+    }
+
+    koPoint = -1;
+    passes = 0;
+    moveCount = 0;
+    toMove = BLACK;
+}
+
+void PlayoutBoard::addEmpty(int idx)
+{
+    emptyPos[idx] = (int16_t)emptyCount;
+    emptyList[emptyCount++] = (int16_t)idx;
+}
+
+void PlayoutBoard::removeEmpty(int idx)
+{
+    int pos = emptyPos[idx];
+    int last = emptyList[--emptyCount];
+    emptyList[pos] = (int16_t)last;
+    emptyPos[last] = (int16_t)pos;
+}
+
+bool PlayoutBoard::isSuicide(int idx, uint8_t color) const
+{
+    uint8_t enemy = opponent(color);
+
+    for(int d = 0; d < 4; ++d)
+    {
+        int n = idx + offsets[d];
+        uint8_t c = cell[n];
+        if(c == EMPTY) return false;
+        if(c == BORDER) continue;
+
+        // Số cạnh chuỗi này chạm vào ô idx
+        int h = head[n];
+        int edges = 0;
+        for(int k = 0; k < 4; ++k)
+        {
+            int m = idx + offsets[k];
+            if(cell[m] == c && head[m] == h) edges++;
+        }
+
+        if(c == color && libs[h] > edges) return false;  // chuỗi mình còn khí khác
+        if(c == enemy && libs[h] == edges) return false; // ăn được chuỗi đối phương
+    }
+    return true;
+}
+
+bool PlayoutBoard::isLegal(int idx, uint8_t color) const
+{
+    if(cell[idx] != EMPTY || idx == koPoint) return false;
+    return !isSuicide(idx, color);
+}
+
+bool PlayoutBoard::isEye(int idx, uint8_t color) const
+{
+    for(int d = 0; d < 4; ++d)
+    {
+        uint8_t c = cell[idx + offsets[d]];
+        if(c != color && c != BORDER) return false;
+    }
+
+    uint8_t enemy = opponent(color);
+    int enemyDiagonals = 0;
+    bool atEdge = false;
+    for(int d = 0; d < 4; ++d)
+    {
+        uint8_t c = cell[idx + diagonals[d]];
+        if(c == enemy) enemyDiagonals++;
+        else if(c == BORDER) atEdge = true;
+    }
+
+    return enemyDiagonals < (atEdge ? 1 : 2);
+}
+
+void PlayoutBoard::mergeGroups(int a, int b)
+{
+    if(stones[a] < stones[b]) std::swap(a, b);
+
+    int s = b;
+    do
+    {
+        head[s] = (int16_t)a;
+        s = next[s];
+    } while(s != b);
+
+    std::swap(next[a], next[b]);
+    stones[a] = (int16_t)(stones[a] + stones[b]);
+    libs[a] = (int16_t)(libs[a] + libs[b]);
+}
+
+void PlayoutBoard::removeGroup(int h)
+{
+    int s = h;
+    do
+    {
+        cell[s] = EMPTY;
+        addEmpty(s);
+        s = next[s];
+    } while(s != h);
+
+    // Trả khí cho các chuỗi kề (chính chuỗi này đã bị xóa nên không tự đếm)
+    s = h;
+    do
+    {
+        for(int d = 0; d < 4; ++d)
+        {
+            int n = s + offsets[d];
+            if(cell[n] == BLACK || cell[n] == WHITE) libs[head[n]]++;
+        }
+        int nextStone = next[s];
+        head[s] = -1;
+        s = nextStone;
+    } while(s != h);
+}
+
+void PlayoutBoard::play(int idx, uint8_t color)
+{
+    moveCount++;
+    toMove = opponent(color);
+
+    // Pass giữ nguyên điểm ko, giống GameLogic
+    if(idx == PASS)
+    {
+        passes++;
+        return;
+    }
+
+    passes = 0;
+    removeEmpty(idx);
+    cell[idx] = color;
+    head[idx] = (int16_t)idx;
+    next[idx] = (int16_t)idx;
+    stones[idx] = 1;
+    libs[idx] = 0;
+
+    for(int d = 0; d < 4; ++d)
+    {
+        int n = idx + offsets[d];
+        uint8_t c = cell[n];
+        if(c == EMPTY) libs[idx]++;
+        else if(c != BORDER) libs[head[n]]--;
+    }
+
+    for(int d = 0; d < 4; ++d)
+    {
+        int n = idx + offsets[d];
+        if(cell[n] == color && head[n] != head[idx]) mergeGroups(head[n], head[idx]);
+    }
+
+    uint8_t enemy = opponent(color);
+    int capturedStones = 0;
+    int capturedPoint = -1;
+    for(int d = 0; d < 4; ++d)
+    {
+        int n = idx + offsets[d];
+        if(cell[n] == enemy && libs[head[n]] == 0)
+        {
+            capturedStones += stones[head[n]];
+            capturedPoint = n;
+            removeGroup(head[n]);
+        }
+    }
+
+    // Ko theo luật của GameLogic: ăn đúng một quân và chuỗi vừa đặt chỉ còn đúng một khí
+    // (khí giả đều trỏ về ô vừa bị ăn)
+    koPoint = -1;
+    if(capturedStones == 1)
+    {
+        int h = head[idx];
+        int edges = 0;
+        for(int d = 0; d < 4; ++d)
+        {
+            int n = capturedPoint + offsets[d];
+            if(cell[n] == color && head[n] == h) edges++;
+        }
+        if(libs[h] == edges) koPoint = capturedPoint;
+    }
+}
+
+uint8_t PlayoutBoard::owner(int idx) const
+{
+    uint8_t c = cell[idx];
+    if(c != EMPTY) return c;
+
+    uint8_t found = EMPTY;
+    for(int d = 0; d < 4; ++d)
+    {
+        uint8_t n = cell[idx + offsets[d]];
+        if(n == BORDER) continue;
+        if(n == EMPTY) return EMPTY;
+        if(found != EMPTY && found != n) return EMPTY;
+        found = n;
+    }
+    return found;
+}
+
+float PlayoutBoard::score(float komi) const
+{
+    int total = 0;
+    for(int y = 0; y < size; ++y)
+    {
+        for(int x = 0; x < size; ++x)
+        {
+            uint8_t o = owner(toIndex(x, y));
+            if(o == BLACK) total++;
+            else if(o == WHITE) total--;
+        }
+    }
+    return (float)total - komi;
+}
+
+// ================= MCTSBot =================
+
+MCTSBot::MCTSBot(int size, int timeLimitMs, int maxNodes)
+    : m_boardSize(size), m_timeLimitMs(timeLimitMs), m_maxPlayouts(0)
+{
+    setSeed((uint64_t)std::time(nullptr));
+    m_nodes.resize(maxNodes);
+    setBoardSize(size);
+}
+
+MCTSBot::~MCTSBot()
+{
+    stopPonder();
+}
+
+void MCTSBot::init()
+{
+    stopPonder();
+    m_board.reset(m_boardSize);
+    m_treeValid = false;
+    m_lastGenerated = PlayoutBoard::EMPTY;
+}
+
+void MCTSBot::setBoardSize(int size)
+{
+    m_boardSize = size;
+    init();
+}
+
+void MCTSBot::setPondering(bool enabled)
+{
+    if(!enabled) stopPonder();
+    m_pondering = enabled;
+}
+
+void MCTSBot::syncMove(std::string color, int x, int y)
+{
+    stopPonder();
+
+    uint8_t c = (color == "black") ? PlayoutBoard::BLACK : PlayoutBoard::WHITE;
+
+    int move = PlayoutBoard::PASS;
+    if(x >= 0 && x < m_boardSize && y >= 0 && y < m_boardSize)
+    {
+        move = m_board.toIndex(x, y);
+        if(m_board.cell[move] != PlayoutBoard::EMPTY)
+        {
+            m_treeValid = false;
+            return;
+        }
+    }
+
+    m_board.play(move, c);
+
+    // Giữ lại cây con của nước vừa đi nếu cây đang chờ đúng bên này
+    if(m_treeValid && c == m_rootColor) advanceTree(move);
+    else m_treeValid = false;
+
+    if(m_pondering && c == m_lastGenerated)
+    {
+        m_lastGenerated = PlayoutBoard::EMPTY;
+        startPonder();
+    }
+}
+
+void MCTSBot::resetTree(uint8_t color)
+{
+    m_rootColor = color;
+    m_nodeCount = 0;
+    newNode(PlayoutBoard::PASS);
+
+    std::memcpy(&m_scratch, &m_board, sizeof(PlayoutBoard));
+    m_scratch.toMove = color;
+    expand(0, m_scratch);
+    m_treeValid = true;
+}
+
+void MCTSBot::advanceTree(int move)
+{
+    const Node& root = m_nodes[0];
+    int child = -1;
+    for(int i = 0; i < root.childCount; ++i)
+    {
+        if(m_nodes[root.firstChild + i].move == move)
+        {
+            child = root.firstChild + i;
+            break;
+        }
+    }
+
+    if(child < 0)
+    {
+        m_treeValid = false;
+        return;
+    }
+
+    // Chép cây con sang m_spare theo chiều rộng: con của mỗi nút vẫn nằm liền nhau
+    if(m_spare.size() != m_nodes.size()) m_spare.resize(m_nodes.size());
+
+    m_spare[0] = m_nodes[child];
+    int count = 1;
+    for(int i = 0; i < count; ++i)
+    {
+        Node& n = m_spare[i];
+        if(n.childCount == 0) continue;
+
+        std::memcpy(&m_spare[count], &m_nodes[n.firstChild], sizeof(Node) * n.childCount);
+        n.firstChild = count;
+        count += n.childCount;
+    }
+
+    m_nodes.swap(m_spare);
+    m_nodeCount = count;
+    m_rootColor = PlayoutBoard::opponent(m_rootColor);
+
+    if(m_nodes[0].childCount == 0)
+    {
+        std::memcpy(&m_scratch, &m_board, sizeof(PlayoutBoard));
+        m_scratch.toMove = m_rootColor;
+        expand(0, m_scratch);
+    }
+}
+
+void MCTSBot::startPonder()
+{
+    if(!m_treeValid) resetTree(m_board.toMove);
+    if(m_nodes[0].childCount <= 1) return;
+
+    m_ponderStop = false;
+    m_ponderThread = std::thread([this]()
+    {
+        // Pool đầy thì cây thôi lớn nhưng thống kê ở các nút vẫn tiếp tục được làm mịn
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_timeLimitMs * PONDER_TIME_FACTOR);
+        int playouts = 0;
+        while(!m_ponderStop.load(std::memory_order_relaxed))
+        {
+            simulate();
+            if((++playouts & 255) == 0 && m_timeLimitMs > 0 && std::chrono::steady_clock::now() >= deadline) break;
+        }
+    });
+}
+
+void MCTSBot::stopPonder()
+{
+    if(m_ponderThread.joinable())
+    {
+        m_ponderStop = true;
+        m_ponderThread.join();
+    }
+}
+
+int MCTSBot::newNode(int move)
+{
+    Node& n = m_nodes[m_nodeCount];
+    n.move = move;
+    n.firstChild = -1;
+    n.childCount = 0;
+    n.visits = 0.0f;
+    n.wins = 0.0f;
+    n.raveVisits = 0.0f;
+    n.raveWins = 0.0f;
+    return m_nodeCount++;
+}
+
+void MCTSBot::expand(int nodeIdx, const PlayoutBoard& board)
+{
+    // Hết chỗ trong pool thì để nút là lá, playout vẫn chạy bình thường
+    if(m_nodeCount + board.emptyCount + 1 > (int)m_nodes.size()) return;
+
+    uint8_t color = board.toMove;
+    int first = m_nodeCount;
+
+    for(int y = 0; y < board.size; ++y)
+    {
+        for(int x = 0; x < board.size; ++x)
+        {
+            int idx = board.toIndex(x, y);
+            if(board.cell[idx] == PlayoutBoard::EMPTY && !board.isEye(idx, color) && board.isLegal(idx, color))
+            {
+                newNode(idx);
+            }
+        }
+    }
+
+    int pass = newNode(PlayoutBoard::PASS);
+    m_nodes[pass].visits = PASS_PRIOR_VISITS;
+
+    m_nodes[nodeIdx].firstChild = first;
+    m_nodes[nodeIdx].childCount = m_nodeCount - first;
+}
+
+int MCTSBot::selectChild(int nodeIdx)
+{
+    const Node& parent = m_nodes[nodeIdx];
+    float logParent = std::log(parent.visits + 1.0f);
+
+    int best = parent.firstChild;
+    float bestValue = -1.0f;
+
+    for(int i = 0; i < parent.childCount; ++i)
+    {
+        int c = parent.firstChild + i;
+        const Node& child = m_nodes[c];
+
+        float value;
+        if(child.visits == 0.0f && child.raveVisits == 0.0f)
+        {
+            value = FIRST_PLAY_URGENCY;
+        }
+        else
+        {
+            float n = child.visits;
+            float rv = child.raveVisits;
+            float q = n > 0.0f ? child.wins / n : 0.0f;
+            float beta = rv > 0.0f ? rv / (rv + n + n * rv / RAVE_EQUIVALENCE) : 0.0f;
+            float amaf = rv > 0.0f ? child.raveWins / rv : 0.0f;
+
+            value = (1.0f - beta) * q + beta * amaf + EXPLORATION * std::sqrt(logParent / (n + 1.0f));
+        }
+
+        if(value > bestValue)
+        {
+            bestValue = value;
+            best = c;
+        }
+    }
+    return best;
+}
+
+int MCTSBot::runPlayout(PlayoutBoard& board, int& length)
+{
+    while(board.passes < 2 && length < MAX_GAME_LENGTH)
+    {
+        uint8_t color = board.toMove;
+        int move = PlayoutBoard::PASS;
+
+        // Bốc ngẫu nhiên từ danh sách ô trống, bỏ qua mắt của mình và nước không hợp lệ
+        if(board.emptyCount > 0)
+        {
+            int start = (int)(nextRandom() % (uint32_t)board.emptyCount);
+            for(int i = 0; i < board.emptyCount; ++i)
+            {
+                int pos = start + i;
+                if(pos >= board.emptyCount) pos -= board.emptyCount;
+
+                int idx = board.emptyList[pos];
+                if(!board.isEye(idx, color) && board.isLegal(idx, color))
+                {
+                    move = idx;
+                    break;
+                }
+            }
+        }
+
+        board.play(move, color);
+        m_sequence[length++] = move;
+    }
+
+    return board.score(m_komi) > 0.0f ? PlayoutBoard::BLACK : PlayoutBoard::WHITE;
+}
+
+void MCTSBot::simulate()
+{
+    PlayoutBoard& board = m_scratch;
+    std::memcpy(&board, &m_board, sizeof(PlayoutBoard));
+    board.toMove = m_rootColor;
+    board.passes = 0;
+
+    // Chọn nút trong cây
+    int node = 0;
+    int depth = 0;
+    int length = 0;
+    m_path[depth++] = 0;
+
+    while(m_nodes[node].childCount > 0 && board.passes < 2 && length < MAX_GAME_LENGTH)
+    {
+        node = selectChild(node);
+        int move = m_nodes[node].move;
+        board.play(move, board.toMove);
+        m_sequence[length++] = move;
+        m_path[depth++] = node;
+    }
+
+    // Mở rộng ở lần ghé thứ hai
+    if(board.passes < 2 && length < MAX_GAME_LENGTH && m_nodes[node].visits > 0.0f)
+    {
+        expand(node, board);
+        if(m_nodes[node].childCount > 0)
+        {
+            node = selectChild(node);
+            int move = m_nodes[node].move;
+            board.play(move, board.toMove);
+            m_sequence[length++] = move;
+            m_path[depth++] = node;
+        }
+    }
+
+    int winner = runPlayout(board, length);
+
+    // Ô -> màu đi đầu tiên tại ô đó, tính từ vị trí i về sau (dựng ngược từ cuối chuỗi)
+    std::memset(m_firstColor, 0, sizeof(m_firstColor));
+    uint8_t opponentColor = PlayoutBoard::opponent(m_rootColor);
+
+    for(int j = length - 1; j >= depth; --j)
+    {
+        if(m_sequence[j] != PlayoutBoard::PASS)
+        {
+            m_firstColor[m_sequence[j]] = (j % 2 == 0) ? m_rootColor : opponentColor;
+        }
+    }
+
+    for(int i = depth - 1; i >= 0; --i)
+    {
+        if(i < length && m_sequence[i] != PlayoutBoard::PASS)
+        {
+            m_firstColor[m_sequence[i]] = (i % 2 == 0) ? m_rootColor : opponentColor;
+        }
+
+        // Nút ở độ sâu i: bên vừa đi là người đi nước dẫn vào nút, bên sắp đi chọn các con
+        Node& n = m_nodes[m_path[i]];
+        uint8_t mover = (i % 2 == 1) ? m_rootColor : opponentColor;
+        uint8_t toPlay = PlayoutBoard::opponent(mover);
+
+        n.visits += 1.0f;
+        if(winner == mover) n.wins += 1.0f;
+
+        float raveResult = (winner == toPlay) ? 1.0f : 0.0f;
+        for(int k = 0; k < n.childCount; ++k)
+        {
+            Node& child = m_nodes[n.firstChild + k];
+            if(child.move != PlayoutBoard::PASS && m_firstColor[child.move] == toPlay)
+            {
+                child.raveVisits += 1.0f;
+                child.raveWins += raveResult;
+            }
+        }
+    }
+}
+
+bool MCTSBot::canStopEarly(int playouts, float elapsedMs, float remainingMs) const
+{
+    // Nước dẫn đầu hơn nước thứ hai nhiều lượt thăm hơn số playout còn chạy kịp thì không thể bị vượt
+    const Node& root = m_nodes[0];
+    float best = 0.0f;
+    float second = 0.0f;
+    for(int i = 0; i < root.childCount; ++i)
+    {
+        float v = m_nodes[root.firstChild + i].visits;
+        if(v > best)
+        {
+            second = best;
+            best = v;
+        }
+        else if(v > second)
+        {
+            second = v;
+        }
+    }
+
+    float remainingPlayouts = (elapsedMs > 0.0f) ? playouts / elapsedMs * remainingMs : 0.0f;
+    return best - second > remainingPlayouts;
+}
+
+BotMove MCTSBot::generateMove(bool isBlackTurn)
+{
+    stopPonder();
+
+    BotMove result;
+    result.isPass = true;
+
+    uint8_t color = isBlackTurn ? PlayoutBoard::BLACK : PlayoutBoard::WHITE;
+
+    // Tìm tiếp trên cây đã có từ lượt trước / lúc ponder nếu còn khớp
+    if(!m_treeValid || m_rootColor != color || m_nodes[0].childCount == 0)
+    {
+        resetTree(color);
+    }
+
+    // Chỉ còn mỗi nước pass
+    if(m_nodes[0].childCount <= 1) return result;
+
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::milliseconds(m_timeLimitMs);
+    int playouts = 0;
+
+    for(;;)
+    {
+        simulate();
+        playouts++;
+
+        if(m_maxPlayouts > 0 && playouts >= m_maxPlayouts) break;
+        if((playouts & 63) == 0)
+        {
+            if(isStopRequested()) break;
+            if(m_timeLimitMs > 0)
+            {
+                auto now = std::chrono::steady_clock::now();
+                if(now >= deadline) break;
+
+                if((playouts & 1023) == 0)
+                {
+                    float elapsedMs = std::chrono::duration<float, std::milli>(now - start).count();
+                    float remainingMs = std::chrono::duration<float, std::milli>(deadline - now).count();
+                    if(canStopEarly(playouts, elapsedMs, remainingMs)) break;
+                }
+            }
+        }
+    }
+
+    // Chọn nước được thăm nhiều nhất (pass chỉ tính lượt thật, bỏ phần gán sẵn)
+    const Node& root = m_nodes[0];
+    int best = -1;
+    float bestVisits = -1.0f;
+    for(int i = 0; i < root.childCount; ++i)
+    {
+        const Node& child = m_nodes[root.firstChild + i];
+        float visits = child.visits;
+        if(child.move == PlayoutBoard::PASS) visits -= PASS_PRIOR_VISITS;
+
+        if(visits > bestVisits)
+        {
+            bestVisits = visits;
+            best = root.firstChild + i;
+        }
+    }
+
+    m_lastGenerated = color;
+
+    const Node& chosen = m_nodes[best];
+    if(chosen.visits > 0.0f && chosen.wins / chosen.visits < RESIGN_THRESHOLD)
+    {
+        result.isResign = true;
+        return result;
+    }
+
+    if(chosen.move != PlayoutBoard::PASS)
+    {
+        result.isPass = false;
+        result.x = m_board.indexX(chosen.move);
+        result.y = m_board.indexY(chosen.move);
+    }
+    return result;
+}
+
+std::vector<BoardPoint> MCTSBot::getDeadStones()
+{
+    stopPonder();
+
+    // Quân bị đối phương chiếm đất trong đa số playout được coi là quân chết
+    std::vector<int> ownedByOpponent(PlayoutBoard::CELLS, 0);
+
+    for(int p = 0; p < DEAD_STONE_PLAYOUTS; ++p)
+    {
+        std::memcpy(&m_scratch, &m_board, sizeof(PlayoutBoard));
+        m_scratch.toMove = (p % 2 == 0) ? PlayoutBoard::BLACK : PlayoutBoard::WHITE;
+        m_scratch.passes = 0;
+
+        int length = 0;
+        runPlayout(m_scratch, length);
+
+        for(int y = 0; y < m_boardSize; ++y)
+        {
+            for(int x = 0; x < m_boardSize; ++x)
+            {
+                int idx = m_board.toIndex(x, y);
+                uint8_t c = m_board.cell[idx];
+                if(c != PlayoutBoard::EMPTY && m_scratch.owner(idx) == PlayoutBoard::opponent(c))
+                {
+                    ownedByOpponent[idx]++;
+                }
+            }
+        }
+    }
+
+    std::vector<BoardPoint> dead;
+    for(int y = 0; y < m_boardSize; ++y)
+    {
+        for(int x = 0; x < m_boardSize; ++x)
+        {
+            if(ownedByOpponent[m_board.toIndex(x, y)] * 2 > DEAD_STONE_PLAYOUTS)
+            {
+                dead.push_back(BoardPoint(x, y));
+            }
+        }
+    }
+    return dead;
+}
@@ -1,8 +1,65 @@
 #include "MiniMaxBot.h"
 #include <iostream>
+#include <atomic>
 
 const int INF = 1000000000;
 
+namespace
+{
+    struct ZobristKeys
+    {
+        uint64_t stone[2][BitBoard::WORDS * 64];
+        uint64_t blackToMove;
+        uint64_t blackPerspective;
+
+        ZobristKeys()
+        {
+            uint64_t state = 0x4D4D42ULL;
+            auto next = [&state]()
+            {
+                uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                return z ^ (z >> 31);
+            };
+
+            for(auto& plane : stone)
+            {
+                for(auto& key : plane) key = next();
+            }
+            blackToMove = next();
+            blackPerspective = next();
+        }
+    };
+
+    const ZobristKeys& zobrist()
+    {
+        static const ZobristKeys keys;
+        return keys;
+    }
+
+    uint64_t hashStones(const BitBoard& set, int color)
+    {
+        BitBoard stones = set;
+        uint64_t h = 0;
+        while(!stones.isZero())
+        {
+            int idx = stones.lowestBit();
+            stones.reset(idx);
+            h ^= zobrist().stone[color][idx];
+        }
+        return h;
+    }
+}
+
+uint64_t MiniMaxBot::nodeKey(MMStone toMove, MMStone myColor) const
+{
+    uint64_t key = m_hash;
+    if(toMove == MMStone::Black) key ^= zobrist().blackToMove;
+    if(myColor == MMStone::Black) key ^= zobrist().blackPerspective;
+    return key;
+}
+
 BotMove MiniMaxBot::generateMove(bool isBlackTurn)
 {
     BotMove bestMove;
@@ -10,11 +67,18 @@ BotMove MiniMaxBot::generateMove(bool isBlackTurn)
 
     MMStone myColor = isBlackTurn ? MMStone::Black : MMStone::White;
 
-    std::vector<sf::Vector2i> candidates = getCandidateMoves(myColor);
+    m_tt->newSearch();
+    m_stopSearch = false;
+    m_nodes = 0;
+    m_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_timeLimitMs);
 
-    if(candidates.empty())
+    MoveList candidates;
+    getCandidateMoves(myColor, candidates);
+
+    if(candidates.count == 0)
     {
-        if(m_board[m_boardSize/2][m_boardSize/2] == MMStone::Empty)
+        int center = BitBoard::index(m_boardSize / 2, m_boardSize / 2);
+        if(emptyPoints().test(center))
         {
             bestMove.x = m_boardSize / 2;
             bestMove.y = m_boardSize / 2;
@@ -24,261 +88,434 @@ BotMove MiniMaxBot::generateMove(bool isBlackTurn)
         return bestMove;
     }
 
+    // Không giới hạn thời gian: tìm thẳng ở độ sâu m_depth như trước
+    int firstDepth = (m_timeLimitMs > 0) ? 1 : m_depth;
+    int bestIdx = -1;
+
+    for(int depth = firstDepth; depth <= m_depth; ++depth)
+    {
+        // Nước tốt nhất của vòng trước được xét đầu tiên
+        if(bestIdx >= 0)
+        {
+            int* pos = std::find(candidates.moves, candidates.moves + candidates.count, bestIdx);
+            std::rotate(candidates.moves, pos, pos + 1);
+        }
+
+        int found = (m_threads > 1) ? searchRootParallel(depth, myColor, candidates)
+                                    : searchRoot(depth, myColor, candidates);
+
+        if(m_stopSearch)
+        {
+            // Vòng dở dang vẫn dùng được nếu đã xét xong ít nhất một nước
+            if(found >= 0) bestIdx = found;
+            break;
+        }
+        bestIdx = found;
+    }
+
+    if(bestIdx >= 0)
+    {
+        bestMove.x = bestIdx % BitBoard::STRIDE;
+        bestMove.y = bestIdx / BitBoard::STRIDE;
+        bestMove.isPass = false;
+
+        if(!isLegalMove(bestMove.x, bestMove.y, myColor))
+        {
+            bestMove.isPass = true;
+        }
+    }
+
+    return bestMove;
+}
+
+int MiniMaxBot::searchRoot(int depth, MMStone myColor, MoveList& candidates)
+{
     int alpha = -INF;
     int beta = INF;
     int bestVal = -INF;
+    int bestIdx = -1;
 
-    for(const auto& move : candidates)
+    for(int i = 0; i < candidates.count; ++i)
     {
-        if(!isLegalMove(move.x, move.y, myColor)) continue;
-
-        std::vector<std::vector<MMStone>> backup = m_board;
+        int idx = candidates.moves[i];
 
-        int capturedBonus = simulateMove(move.x, move.y, myColor, backup) * 1000;
+        int capturedBonus = makeMove(idx, myColor) * 1000;
 
-        int moveVal = minimax(m_depth - 1, false, myColor, alpha, beta);
+        int moveVal = minimax(depth - 1, false, myColor, alpha, beta);
         moveVal += capturedBonus;
 
-        m_board = backup;
+        unmakeMove();
+
+        if(m_stopSearch) break;
 
         if(moveVal > bestVal)
         {
             bestVal = moveVal;
-            bestMove.x = move.x;
-            bestMove.y = move.y;
-            bestMove.isPass = false;
+            bestIdx = idx;
         }
 
         if(moveVal == bestVal)
         {
             if(std::rand() % 100 < 30)
             {
-                bestMove.x = move.x;
-                bestMove.y = move.y;
+                bestIdx = idx;
             }
         }
 
         alpha = std::max(alpha, bestVal);
     }
 
-    if(!bestMove.isPass)
+    return bestIdx;
+}
+
+int MiniMaxBot::searchRootParallel(int depth, MMStone myColor, MoveList& candidates)
+{
+    if(!m_pool)
     {
-        if(!isLegalMove(bestMove.x, bestMove.y, myColor))
+        m_pool.reset(new ThreadPool(m_threads));
+        for(int t = 0; t < m_threads; ++t)
         {
-            bestMove.isPass = true;
+            m_helpers.emplace_back(new MiniMaxBot(m_tt));
+            m_helpers.back()->m_stopSource = this;
         }
     }
 
-    return bestMove;
+    int values[BitBoard::MAX_SIZE * BitBoard::MAX_SIZE];
+    bool done[BitBoard::MAX_SIZE * BitBoard::MAX_SIZE] = {};
+    std::atomic<int> nextMove(0);
+
+    for(auto& helper : m_helpers)
+    {
+        MiniMaxBot* h = helper.get();
+        h->m_boardSize = m_boardSize;
+        h->m_onBoard = m_onBoard;
+        h->m_black = m_black;
+        h->m_white = m_white;
+        h->m_hash = m_hash;
+        h->m_undoStack.clear();
+        h->m_timeLimitMs = m_timeLimitMs;
+        h->m_deadline = m_deadline;
+        h->m_stopSearch = false;
+        h->m_nodes = 0;
+
+        // Cửa sổ đầy đủ ở mỗi nhánh gốc: giá trị chính xác, không phụ thuộc nhánh nào xong trước
+        m_pool->submit([h, depth, myColor, &candidates, &values, &done, &nextMove]()
+        {
+            for(;;)
+            {
+                int i = nextMove.fetch_add(1);
+                if(i >= candidates.count) break;
+
+                int idx = candidates.moves[i];
+                int capturedBonus = h->makeMove(idx, myColor) * 1000;
+                int moveVal = h->minimax(depth - 1, false, myColor, -INF, INF);
+                h->unmakeMove();
+
+                if(h->m_stopSearch) break;
+
+                values[i] = moveVal + capturedBonus;
+                done[i] = true;
+            }
+        });
+    }
+    m_pool->wait();
+
+    for(auto& helper : m_helpers)
+    {
+        if(helper->m_stopSearch) m_stopSearch = true;
+    }
+
+    return pickRootMove(candidates, values, done);
+}
+
+int MiniMaxBot::pickRootMove(const MoveList& candidates, const int* values, const bool* done)
+{
+    // Chọn tuần tự theo thứ tự ứng viên để rand() được gọi như nhau ở mọi lần chạy
+    int bestVal = -INF;
+    int bestIdx = -1;
+
+    for(int i = 0; i < candidates.count; ++i)
+    {
+        if(!done[i]) continue;
+
+        if(values[i] > bestVal)
+        {
+            bestVal = values[i];
+            bestIdx = candidates.moves[i];
+        }
+
+        if(values[i] == bestVal)
+        {
+            if(std::rand() % 100 < 30)
+            {
+                bestIdx = candidates.moves[i];
+            }
+        }
+    }
+    return bestIdx;
 }
 
 int MiniMaxBot::minimax(int depth, bool isMaximizing, MMStone myColor, int alpha, int beta)
 {
+    if(m_stopSearch) return 0;
+    if((++m_nodes & 1023) == 0)
+    {
+        // Hết giờ, hoặc lượt startMove của bot chính bị hủy
+        if(m_stopSource->isStopRequested() ||
+           (m_timeLimitMs > 0 && std::chrono::steady_clock::now() >= m_deadline))
+        {
+            m_stopSearch = true;
+            return 0;
+        }
+    }
+
     if(depth == 0) return evaluate(myColor);
 
     MMStone currentPlayer = isMaximizing ? myColor : (myColor == MMStone::Black ? MMStone::White : MMStone::Black);
 
-    std::vector<sf::Vector2i> candidates = getCandidateMoves(currentPlayer);
+    uint64_t key = nodeKey(currentPlayer, myColor);
+    int ttMove = -1;
 
-    if(candidates.empty()) return evaluate(myColor);
+    TTEntry entry;
+    if(m_tt->probe(key, entry))
+    {
+        ttMove = entry.bestMove;
+        if(m_exactDepthProbe ? entry.depth == depth : entry.depth >= depth)
+        {
+            if(entry.bound == TTBound::Exact) return entry.score;
+            if(entry.bound == TTBound::Lower) alpha = std::max(alpha, entry.score);
+            else if(entry.bound == TTBound::Upper) beta = std::min(beta, entry.score);
+            if(beta <= alpha) return entry.score;
+        }
+    }
 
-    if(isMaximizing)
+    MoveList candidates;
+    getCandidateMoves(currentPlayer, candidates);
+
+    if(candidates.count == 0) return evaluate(myColor);
+
+    // Nước tốt nhất đã lưu được thử trước để cắt tỉa sớm
+    if(ttMove >= 0)
     {
-        int maxEval = -INF;
-        for(const auto& move : candidates)
+        for(int i = 0; i < candidates.count; ++i)
         {
-            if(!isLegalMove(move.x, move.y, currentPlayer)) continue;
+            if(candidates.moves[i] == ttMove)
+            {
+                std::swap(candidates.moves[0], candidates.moves[i]);
+                break;
+            }
+        }
+    }
 
-            std::vector<std::vector<MMStone>> backup = m_board;
-            simulateMove(move.x, move.y, currentPlayer, backup);
+    int windowAlpha = alpha;
+    int windowBeta = beta;
+    int bestEval;
+    int bestIdx = -1;
 
+    if(isMaximizing)
+    {
+        bestEval = -INF;
+        for(int i = 0; i < candidates.count; ++i)
+        {
+            makeMove(candidates.moves[i], currentPlayer);
             int eval = minimax(depth - 1, false, myColor, alpha, beta);
-            m_board = backup;
+            unmakeMove();
+            if(m_stopSearch) return 0;
 
-            maxEval = std::max(maxEval, eval);
+            if(eval > bestEval || bestIdx < 0)
+            {
+                bestEval = eval;
+                bestIdx = candidates.moves[i];
+            }
             alpha = std::max(alpha, eval);
             if(beta <= alpha) break;
         }
-        return maxEval;
     }
     else
     {
-        int minEval = INF;
-        for(const auto& move : candidates)
+        bestEval = INF;
+        for(int i = 0; i < candidates.count; ++i)
         {
-            if(!isLegalMove(move.x, move.y, currentPlayer)) continue;
-
-            std::vector<std::vector<MMStone>> backup = m_board;
-            simulateMove(move.x, move.y, currentPlayer, backup);
-
+            makeMove(candidates.moves[i], currentPlayer);
             int eval = minimax(depth - 1, true, myColor, alpha, beta);
-            m_board = backup;
+            unmakeMove();
+            if(m_stopSearch) return 0;
 
-            minEval = std::min(minEval, eval);
+            if(eval < bestEval || bestIdx < 0)
+            {
+                bestEval = eval;
+                bestIdx = candidates.moves[i];
+            }
             beta = std::min(beta, eval);
             if(beta <= alpha) break;
         }
-        return minEval;
     }
+
+    TTBound bound = TTBound::Exact;
+    if(bestEval <= windowAlpha) bound = TTBound::Upper;
+    else if(bestEval >= windowBeta) bound = TTBound::Lower;
+    m_tt->store(key, bestEval, depth, bound, bestIdx);
+
+    return bestEval;
 }
 
 bool MiniMaxBot::isLegalMove(int x, int y, MMStone myColor)
 {
     if(!isValid(x, y)) return false;
-    if(m_board[y][x] != MMStone::Empty) return false;
 
-    m_board[y][x] = myColor;
+    int idx = BitBoard::index(x, y);
+    BitBoard empty = emptyPoints();
+    if(!empty.test(idx)) return false;
 
-    bool capturesEnemy = false;
-    MMStone enemyColor = (myColor == MMStone::Black) ? MMStone::White : MMStone::Black;
+    BitBoard stone = BitBoard::single(idx);
+    BitBoard mine = stonesOf(myColor) | stone;
+    BitBoard enemy = stonesOf(myColor == MMStone::Black ? MMStone::White : MMStone::Black);
+    empty = empty.andNot(stone);
 
-    for(int i = 0; i < 4; ++i)
+    // Bắt được quân đối phương thì luôn hợp lệ
+    BitBoard enemyAdj = stone.neighbors(m_onBoard) & enemy;
+    while(!enemyAdj.isZero())
     {
-        int nx = x + DX[i];
-        int ny = y + DY[i];
-        if(isValid(nx, ny) && m_board[ny][nx] == enemyColor)
+        BitBoard group = BitBoard::single(enemyAdj.lowestBit()).floodFill(enemy, m_onBoard);
+        if((group.neighbors(m_onBoard) & empty).isZero())
         {
-            std::vector<std::vector<bool>> visited(m_boardSize, std::vector<bool>(m_boardSize, false));
-            if(countLiberties(nx, ny, enemyColor, visited) == 0)
-            {
-                capturesEnemy = true;
-                break;
-            }
+            return true;
         }
+        enemyAdj = enemyAdj.andNot(group);
     }
 
-    std::vector<std::vector<bool>> visited(m_boardSize, std::vector<bool>(m_boardSize, false));
-    int myLibs = countLiberties(x, y, myColor, visited);
-
-    m_board[y][x] = MMStone::Empty;
-
-    if(!capturesEnemy && myLibs == 0)
-    {
-        return false;
-    }
-
-    return true;
+    BitBoard myGroup = stone.floodFill(mine, m_onBoard);
+    return !(myGroup.neighbors(m_onBoard) & empty).isZero();
 }
 
 int MiniMaxBot::evaluate(MMStone myColor)
 {
     int score = 0;
-    MMStone enemyColor = (myColor == MMStone::Black) ? MMStone::White : MMStone::Black;
+    BitBoard empty = emptyPoints();
 
-    for(int y = 0; y < m_boardSize; ++y)
+    // Duyệt theo chuỗi thay vì từng quân: mọi quân trong chuỗi có cùng số khí
+    for(int c = 0; c < 2; ++c)
     {
-        for(int x = 0; x < m_boardSize; ++x)
+        MMStone s = (c == 0) ? MMStone::Black : MMStone::White;
+        BitBoard stones = stonesOf(s);
+        BitBoard remaining = stones;
+
+        while(!remaining.isZero())
         {
-            MMStone s = m_board[y][x];
-            if(s == MMStone::Empty) continue;
+            BitBoard group = BitBoard::single(remaining.lowestBit()).floodFill(stones, m_onBoard);
+            remaining = remaining.andNot(group);
 
-            std::vector<std::vector<bool>> visited(m_boardSize, std::vector<bool>(m_boardSize, false));
-            int liberties = countLiberties(x, y, s, visited);
+            int size = group.popcount();
+            int liberties = group.pseudoLiberties(empty);
 
             if(s == myColor)
             {
-                score += 10;
-                if(liberties == 1) score -= 500;
-                else if(liberties >= 4) score += 50;
+                score += 10 * size;
+                if(liberties == 1) score -= 500 * size;
+                else if(liberties >= 4) score += 50 * size;
             }
             else
             {
-                score -= 10;
-                if(liberties == 1) score += 600;
+                score -= 10 * size;
+                if(liberties == 1) score += 600 * size;
             }
         }
     }
     return score;
 }
 
-int MiniMaxBot::simulateMove(int x, int y, MMStone color, std::vector<std::vector<MMStone>>& backupBoard)
+BitBoard MiniMaxBot::playStone(int idx, MMStone color)
 {
-    m_board[y][x] = color;
-    MMStone enemy = (color == MMStone::Black) ? MMStone::White : MMStone::Black;
-    int capturedTotal = 0;
+    BitBoard stone = BitBoard::single(idx);
 
-    for(int i = 0; i < 4; ++i)
-    {
-        int nx = x + DX[i];
-        int ny = y + DY[i];
+    BitBoard& mine = stonesOf(color);
+    BitBoard& enemy = stonesOf(color == MMStone::Black ? MMStone::White : MMStone::Black);
+
+    mine |= stone;
+    m_hash ^= zobrist().stone[color == MMStone::Black ? 0 : 1][idx];
+    BitBoard empty = emptyPoints();
 
-        if(isValid(nx, ny) && m_board[ny][nx] == enemy)
+    BitBoard captured;
+    BitBoard enemyAdj = stone.neighbors(m_onBoard) & enemy;
+    while(!enemyAdj.isZero())
+    {
+        BitBoard group = BitBoard::single(enemyAdj.lowestBit()).floodFill(enemy, m_onBoard);
+        if((group.neighbors(m_onBoard) & empty).isZero())
         {
-            std::vector<std::vector<bool>> visited(m_boardSize, std::vector<bool>(m_boardSize, false));
-            if(countLiberties(nx, ny, enemy, visited) == 0)
-            {
-                for(int r = 0; r < m_boardSize; ++r)
-                {
-                    for(int c = 0; c < m_boardSize; ++c)
-                    {
-                        if(visited[r][c])
-                        {
-                            m_board[r][c] = MMStone::Empty;
-                            capturedTotal++;
-                        }
-                    }
-                }
-            }
+            captured |= group;
         }
+        enemyAdj = enemyAdj.andNot(group);
     }
-    return capturedTotal;
+
+    enemy = enemy.andNot(captured);
+    if(!captured.isZero())
+    {
+        m_hash ^= hashStones(captured, color == MMStone::Black ? 1 : 0);
+    }
+    return captured;
 }
 
-int MiniMaxBot::countLiberties(int x, int y, MMStone color, std::vector<std::vector<bool>>& visited)
+int MiniMaxBot::makeMove(int idx, MMStone color)
 {
-    if(visited[y][x]) return 0;
-    visited[y][x] = true;
+    UndoEntry entry;
+    entry.index = idx;
+    entry.color = color;
+    entry.captured = playStone(idx, color);
+    m_undoStack.push_back(entry);
+    return entry.captured.popcount();
+}
 
-    int liberties = 0;
-    for(int i = 0; i < 4; ++i)
-    {
-        int nx = x + DX[i];
-        int ny = y + DY[i];
-        if(!isValid(nx, ny)) continue;
+void MiniMaxBot::unmakeMove()
+{
+    const UndoEntry& entry = m_undoStack.back();
 
-        if(m_board[ny][nx] == MMStone::Empty)
-        {
-            liberties++;
-        }
-        else if(m_board[ny][nx] == color && !visited[ny][nx])
-        {
-            liberties += countLiberties(nx, ny, color, visited);
-        }
+    int color = (entry.color == MMStone::Black) ? 0 : 1;
+
+    stonesOf(entry.color).reset(entry.index);
+    m_hash ^= zobrist().stone[color][entry.index];
+
+    if(!entry.captured.isZero())
+    {
+        stonesOf(entry.color == MMStone::Black ? MMStone::White : MMStone::Black) |= entry.captured;
+        m_hash ^= hashStones(entry.captured, 1 - color);
     }
-    return liberties;
+
+    m_undoStack.pop_back();
 }
 
-std::vector<sf::Vector2i> MiniMaxBot::getCandidateMoves(MMStone myColor)
+void MiniMaxBot::getCandidateMoves(MMStone myColor, MoveList& moves)
 {
-    std::vector<sf::Vector2i> moves;
-    std::vector<std::vector<bool>> marked(m_boardSize, std::vector<bool>(m_boardSize, false));
-    bool hasStone = false;
+    BitBoard empty = emptyPoints();
+    BitBoard marked;
 
-    for(int y = 0; y < m_boardSize; ++y)
+    // Bit tăng dần tương ứng thứ tự duyệt theo hàng rồi theo cột
+    BitBoard stones = m_black | m_white;
+    while(!stones.isZero())
     {
-        for(int x = 0; x < m_boardSize; ++x)
+        int idx = stones.lowestBit();
+        stones.reset(idx);
+
+        int x = idx % BitBoard::STRIDE;
+        int y = idx / BitBoard::STRIDE;
+
+        for(int dy = -1; dy <= 1; ++dy)
         {
-            if(m_board[y][x] != MMStone::Empty)
+            for(int dx = -1; dx <= 1; ++dx)
             {
-                hasStone = true;
-                for(int dy = -1; dy <= 1; ++dy)
+                int nx = x + dx;
+                int ny = y + dy;
+                if(!isValid(nx, ny)) continue;
+
+                int n = BitBoard::index(nx, ny);
+                if(empty.test(n) && !marked.test(n))
                 {
-                    for(int dx = -1; dx <= 1; ++dx)
+                    marked.set(n);
+                    if(isLegalMove(nx, ny, myColor))
                     {
-                        int nx = x + dx;
-                        int ny = y + dy;
-                        if(isValid(nx, ny) && m_board[ny][nx] == MMStone::Empty && !marked[ny][nx])
-                        {
-                            if(isLegalMove(nx, ny, myColor))
-                            {
-                                moves.push_back({nx, ny});
-                                marked[ny][nx] = true;
-                            }
-                        }
+                        moves.push(n);
                     }
                 }
             }
         }
     }
-    return moves;
 }
@@ -1,6 +1,39 @@
 #include "ResourceManager.h"
 #include <iostream>
 #include <cassert>
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+    const unsigned int ATLAS_PAGE_SIZE = 2048;
+    const unsigned int ATLAS_MAX_IMAGE_SIZE = 640;   // ảnh lớn hơn (nền, bàn cờ) giữ texture riêng
+    const unsigned int ATLAS_EXTRUDE = 4;            // lặp viền ảnh ra ngoài để lọc mịn/mipmap không lấy màu ảnh bên cạnh
+    const std::string ATLAS_SOLID_KEY = "atlas_solid";
+
+    sf::Image makeSolidImage()
+    {
+        sf::Image solid;
+        solid.create(4, 4, sf::Color::White);
+        return solid;
+    }
+
+    // Chép ảnh vào trang atlas tại (x, y) kèm viền lặp lại ATLAS_EXTRUDE điểm ảnh mỗi phía
+    void blitExtruded(sf::Image& page, const sf::Image& image, unsigned int x, unsigned int y)
+    {
+        sf::Vector2u size = image.getSize();
+        int e = (int)ATLAS_EXTRUDE;
+        for(int dy = -e; dy < (int)size.y + e; ++dy)
+        {
+            int sy = std::min(std::max(dy, 0), (int)size.y - 1);
+            for(int dx = -e; dx < (int)size.x + e; ++dx)
+            {
+                int sx = std::min(std::max(dx, 0), (int)size.x - 1);
+                page.setPixel(x + dx, y + dy, image.getPixel(sx, sy));
+            }
+        }
+    }
+}
 
 ResourceManager& ResourceManager::getInstance()
 {
@@ -8,10 +41,53 @@ ResourceManager& ResourceManager::getInstance()
     return instance;
 }
 
-void ResourceManager::loadTexture(const std::string& key, const std::string& filePath)
+bool ResourceManager::mountArchive(const std::string& archivePath)
+{
+    if(!m_archive.open(archivePath)) return false;
+
+    std::cout << "[ResourceManager] Mounted " << archivePath << " (" << m_archive.getEntryCount() << " files)\n";
+    return true;
+}
+
+bool ResourceManager::findPacked(const std::string& filePath, AssetArchive::Blob& blob) const
+{
+    return m_archive.isOpen() && m_archive.find(filePath, blob);
+}
+
+void ResourceManager::loadTexture(const std::string& key, const std::string& filePath, bool packInAtlas)
+{
+    if(!packInAtlas) m_unpackedKeys.insert(key);
+
+    sf::Image image;
+    AssetArchive::Blob blob;
+    bool loaded = findPacked(filePath, blob) ? image.loadFromMemory(blob.data, blob.size) : image.loadFromFile(filePath);
+    if(!loaded)
+    {
+        std::cerr << "texture " << key << " cannot load!\n";
+        assert(false);
+    }
+
+    addTexture(key, filePath, image);
+}
+
+void ResourceManager::addTexture(const std::string& key, const std::string& filePath, const sf::Image& image)
+{
+    // Ảnh sẽ gộp vào atlas không có texture riêng; getTexture tạo bản riêng khi có nơi cần tới
+    sf::Vector2u size = image.getSize();
+    if(m_atlasPages.empty() && !m_unpackedKeys.count(key) && size.x <= ATLAS_MAX_IMAGE_SIZE && size.y <= ATLAS_MAX_IMAGE_SIZE)
+    {
+        if(m_atlasImages.find(filePath) == m_atlasImages.end()) m_atlasImages[filePath] = image;
+        m_atlasKeyPaths[key] = filePath;
+        return;
+    }
+
+    createTexture(key, image);
+}
+
+void ResourceManager::createTexture(const std::string& key, const sf::Image& image)
 {
     sf::Texture texture;
-    if(!texture.loadFromFile(filePath))
+    if(!texture.loadFromImage(image))
     {
         std::cerr << "texture " << key << " cannot load!\n";
         assert(false);
@@ -23,22 +99,431 @@ void ResourceManager::loadTexture(const std::string& key, const std::string& fil
     m_textures[key] = texture;
 }
 
+bool ResourceManager::copyAtlasImage(const std::string& key, sf::Image& image) const
+{
+    // Atlas chưa dựng (hoặc dựng lỗi): ảnh vẫn còn trong hàng chờ
+    auto pending = m_atlasKeyPaths.find(key);
+    if(pending != m_atlasKeyPaths.end())
+    {
+        image = m_atlasImages.at(pending->second);
+        return true;
+    }
+
+    auto it = m_regions.find(key);
+    if(it == m_regions.end()) return false;
+
+    const TextureRegion& region = it->second;
+    bool onAtlas = std::any_of(m_atlasPages.begin(), m_atlasPages.end(), [&region](const std::unique_ptr<sf::Texture>& page)
+    {
+        return page.get() == region.texture;
+    });
+    if(!onAtlas) return false;
+
+    // Đọc lại cả trang từ GPU cho mỗi key: ảnh hay dùng nguyên texture nên nạp với packInAtlas = false
+    sf::Image page = region.texture->copyToImage();
+    image.create((unsigned int)region.rect.width, (unsigned int)region.rect.height);
+    image.copy(page, 0, 0, region.rect);
+    return true;
+}
+
+void ResourceManager::queueFile(bool isSound, const std::string& key, const std::string& filePath)
+{
+    for(LoadRequest& request : m_loadQueue)
+    {
+        if(request.path == filePath && request.isSound == isSound)
+        {
+            request.keys.push_back(key);
+            return;
+        }
+    }
+
+    LoadRequest request;
+    request.isSound = isSound;
+    request.path = filePath;
+    request.keys.push_back(key);
+    m_loadQueue.push_back(request);
+}
+
+void ResourceManager::queueTexture(const std::string& key, const std::string& filePath, bool packInAtlas)
+{
+    if(!packInAtlas) m_unpackedKeys.insert(key);
+    queueFile(false, key, filePath);
+}
+
+void ResourceManager::queueSoundBuffer(const std::string& key, const std::string& filePath)
+{
+    queueFile(true, key, filePath);
+}
+
+void ResourceManager::startLoading(int threadCount)
+{
+    if(m_loadQueue.empty() || m_loaderPool) return;
+
+    if(threadCount <= 0)
+    {
+        unsigned int cores = std::thread::hardware_concurrency();
+        threadCount = cores > 0 ? (int)cores : 2;
+    }
+
+    m_loadClock.restart();
+    m_loadTotal = m_loadQueue.size();
+    m_loadDone = 0;
+    m_loaderPool = std::make_unique<ThreadPool>(std::min(threadCount, (int)m_loadTotal));
+
+    // Chỉ giải mã trên luồng phụ (không đụng OpenGL/OpenAL); tạo texture và buffer để luồng chính làm
+    for(const LoadRequest& request : m_loadQueue)
+    {
+        m_loaderPool->submit([this, request]()
+        {
+            DecodedResource decoded;
+            decoded.request = request;
+            AssetArchive::Blob blob;
+            bool packed = findPacked(request.path, blob);
+
+            if(request.isSound)
+            {
+                sf::InputSoundFile file;
+                if(packed ? file.openFromMemory(blob.data, blob.size) : file.openFromFile(request.path))
+                {
+                    decoded.samples.resize((size_t)file.getSampleCount());
+                    decoded.ok = file.read(decoded.samples.data(), decoded.samples.size()) == decoded.samples.size();
+                    decoded.channelCount = file.getChannelCount();
+                    decoded.sampleRate = file.getSampleRate();
+                }
+            }
+            else
+            {
+                decoded.ok = packed ? decoded.image.loadFromMemory(blob.data, blob.size) : decoded.image.loadFromFile(request.path);
+            }
+
+            std::lock_guard<std::mutex> lock(m_decodedMutex);
+            m_decoded.push_back(std::move(decoded));
+        });
+    }
+    m_loadQueue.clear();
+}
+
+bool ResourceManager::updateLoading(sf::Time budget)
+{
+    sf::Clock clock;
+    while(m_loadDone < m_loadTotal && clock.getElapsedTime() < budget)
+    {
+        DecodedResource decoded;
+        {
+            std::lock_guard<std::mutex> lock(m_decodedMutex);
+            if(m_decoded.empty()) break;
+            decoded = std::move(m_decoded.front());
+            m_decoded.pop_front();
+        }
+
+        for(const std::string& key : decoded.request.keys)
+        {
+            if(!decoded.ok)
+            {
+                std::cerr << (decoded.request.isSound ? "buffer " : "texture ") << key << " cannot load!\n";
+                assert(false);
+                continue;
+            }
+
+            if(decoded.request.isSound)
+            {
+                m_soundBuffers[key].loadFromSamples(decoded.samples.data(), decoded.samples.size(),
+                                                    decoded.channelCount, decoded.sampleRate);
+            }
+            else
+            {
+                addTexture(key, decoded.request.path, decoded.image);
+            }
+        }
+        m_loadDone++;
+    }
+
+    if(m_loadDone < m_loadTotal) return false;
+
+    if(m_loaderPool)
+    {
+        m_loaderPool.reset();
+        buildAtlas();
+        std::cout << "[ResourceManager] " << m_loadTotal << " files loaded in "
+                  << m_loadClock.getElapsedTime().asMilliseconds() << " ms\n";
+    }
+    return true;
+}
+
+float ResourceManager::getLoadingProgress() const
+{
+    return m_loadTotal ? (float)m_loadDone / m_loadTotal : 1.f;
+}
+
+void ResourceManager::buildAtlas()
+{
+    if(!m_atlasPages.empty() || m_atlasImages.empty()) return;
+
+    // Ô trắng đặc cho các hình tô màu đơn (vd. dấu nước đi cuối) vẽ chung lô với quân cờ
+    m_atlasImages[ATLAS_SOLID_KEY] = makeSolidImage();
+    m_atlasKeyPaths[ATLAS_SOLID_KEY] = ATLAS_SOLID_KEY;
+
+    unsigned int pageSize = std::min(ATLAS_PAGE_SIZE, sf::Texture::getMaximumSize());
+
+    // Xếp theo kệ: ảnh cao trước, mỗi kệ cao bằng ảnh đầu tiên của nó
+    std::vector<const std::string*> order;
+    for(const auto& entry : m_atlasImages) order.push_back(&entry.first);
+    std::sort(order.begin(), order.end(), [this](const std::string* a, const std::string* b)
+    {
+        sf::Vector2u sa = m_atlasImages[*a].getSize();
+        sf::Vector2u sb = m_atlasImages[*b].getSize();
+        return sa.y != sb.y ? sa.y > sb.y : sa.x > sb.x;
+    });
+
+    struct Placement
+    {
+        size_t page;
+        unsigned int x;
+        unsigned int y;
+    };
+    std::map<std::string, Placement> placements;
+    std::vector<unsigned int> pageHeights;
+
+    unsigned int cursorX = 0;
+    unsigned int cursorY = 0;
+    unsigned int shelfHeight = 0;
+    pageHeights.push_back(0);
+
+    for(const std::string* path : order)
+    {
+        sf::Vector2u size = m_atlasImages[*path].getSize();
+        unsigned int w = size.x + ATLAS_EXTRUDE * 2;
+        unsigned int h = size.y + ATLAS_EXTRUDE * 2;
+
+        if(cursorX + w > pageSize)
+        {
+            cursorX = 0;
+            cursorY += shelfHeight;
+            shelfHeight = 0;
+        }
+        if(cursorY + h > pageSize)
+        {
+            pageHeights.push_back(0);
+            cursorX = 0;
+            cursorY = 0;
+            shelfHeight = 0;
+        }
+
+        placements[*path] = {pageHeights.size() - 1, cursorX + ATLAS_EXTRUDE, cursorY + ATLAS_EXTRUDE};
+        cursorX += w;
+        shelfHeight = std::max(shelfHeight, h);
+        pageHeights.back() = std::max(pageHeights.back(), cursorY + h);
+    }
+
+    std::vector<sf::Image> pages(pageHeights.size());
+    for(size_t i = 0; i < pages.size(); ++i) pages[i].create(pageSize, pageHeights[i], sf::Color::Transparent);
+
+    for(const auto& entry : placements)
+    {
+        blitExtruded(pages[entry.second.page], m_atlasImages[entry.first], entry.second.x, entry.second.y);
+    }
+
+    for(const sf::Image& page : pages)
+    {
+        auto texture = std::make_unique<sf::Texture>();
+        if(!texture->loadFromImage(page))
+        {
+            std::cerr << "atlas page cannot be created!\n";
+            m_atlasPages.clear();
+            return;
+        }
+        texture->setSmooth(true);
+        texture->generateMipmap();
+        m_atlasPages.push_back(std::move(texture));
+    }
+
+    for(const auto& entry : m_atlasKeyPaths)
+    {
+        const Placement& place = placements[entry.second];
+        sf::Vector2u size = m_atlasImages[entry.second].getSize();
+
+        TextureRegion region;
+        region.texture = m_atlasPages[place.page].get();
+        region.rect = sf::IntRect((int)place.x, (int)place.y, (int)size.x, (int)size.y);
+        m_regions[entry.first] = region;
+    }
+
+    std::cout << "[ResourceManager] Atlas: " << m_atlasKeyPaths.size() << " textures (" << m_atlasImages.size()
+              << " images) packed into " << m_atlasPages.size() << " page(s)\n";
+
+    m_atlasImages.clear();
+    m_atlasKeyPaths.clear();
+}
+
+const TextureRegion& ResourceManager::getRegion(const std::string& key)
+{
+    auto it = m_regions.find(key);
+    if(it != m_regions.end()) return it->second;
+
+    // Không nằm trong atlas: dùng cả texture riêng
+    const sf::Texture& texture = getTexture(key);
+    TextureRegion region;
+    region.texture = &texture;
+    region.rect = sf::IntRect(0, 0, (int)texture.getSize().x, (int)texture.getSize().y);
+    return m_regions[key] = region;
+}
+
+const TextureRegion& ResourceManager::getSolidRegion()
+{
+    if(m_textures.find(ATLAS_SOLID_KEY) == m_textures.end() && m_regions.find(ATLAS_SOLID_KEY) == m_regions.end())
+    {
+        m_textures[ATLAS_SOLID_KEY].loadFromImage(makeSolidImage());
+    }
+    return getRegion(ATLAS_SOLID_KEY);
+}
+
 sf::Texture& ResourceManager::getTexture(const std::string& key)
 {
     auto it = m_textures.find(key);
-    if(it == m_textures.end())
+    if(it != m_textures.end()) return it -> second;
+
+    // Ảnh trong atlas: tách một texture riêng cho nơi cần cả texture (lặp vân, tự tính kích thước...)
+    sf::Image image;
+    if(copyAtlasImage(key, image))
+    {
+        createTexture(key, image);
+        return m_textures[key];
+    }
+
+    if(m_lazyTextures.count(key)) std::cerr << "texture " << key << " is loaded on demand, use acquireTexture!\n";
+    else std::cerr << "texture " << key << " not found!\n";
+    assert(false);
+
+    return m_textures[key];
+}
+
+void ResourceManager::registerTexture(const std::string& key, const std::string& filePath)
+{
+    LazyTexture& entry = m_lazyTextures[key];
+    entry.key = key;
+    entry.path = filePath;
+}
+
+TextureHandle ResourceManager::acquireTexture(const std::string& key)
+{
+    auto it = m_lazyTextures.find(key);
+    if(it == m_lazyTextures.end())
     {
-        std::cerr << "texture " << key << " not found!\n";
+        std::cerr << "texture " << key << " not registered!\n";
         assert(false);
+        return TextureHandle();
     }
 
-    return it -> second;
+    LazyTexture& entry = it->second;
+    if(entry.cached)
+    {
+        m_lazyLru.erase(entry.lruPos);
+        entry.cached = false;
+        m_lazyCachedBytes -= entry.bytes;
+    }
+    else if(!entry.texture)
+    {
+        entry.texture = std::make_unique<sf::Texture>();
+        AssetArchive::Blob blob;
+        bool loaded = findPacked(entry.path, blob) ? entry.texture->loadFromMemory(blob.data, blob.size)
+                                                   : entry.texture->loadFromFile(entry.path);
+        if(!loaded)
+        {
+            std::cerr << "texture " << key << " cannot load!\n";
+            assert(false);
+        }
+        entry.texture->setSmooth(true);
+        entry.texture->generateMipmap();
+
+        // RGBA, mipmap thêm khoảng 1/3
+        sf::Vector2u size = entry.texture->getSize();
+        entry.bytes = (size_t)size.x * size.y * 4 * 4 / 3;
+        m_lazyResidentBytes += entry.bytes;
+
+        std::cout << "[ResourceManager] Loaded " << key << " (on-demand textures: "
+                  << m_lazyResidentBytes / (1024 * 1024) << " MB)\n";
+    }
+
+    return TextureHandle(&entry);
+}
+
+void ResourceManager::setTextureCacheBudget(size_t bytes)
+{
+    m_lazyBudgetBytes = bytes;
+    trimTextureCache();
+}
+
+void ResourceManager::releaseTexture(LazyTexture& entry)
+{
+    if(--entry.refCount > 0) return;
+
+    m_lazyLru.push_front(&entry);
+    entry.lruPos = m_lazyLru.begin();
+    entry.cached = true;
+    m_lazyCachedBytes += entry.bytes;
+    trimTextureCache();
+}
+
+void ResourceManager::trimTextureCache()
+{
+    while(m_lazyCachedBytes > m_lazyBudgetBytes && !m_lazyLru.empty())
+    {
+        LazyTexture* victim = m_lazyLru.back();
+        m_lazyLru.pop_back();
+
+        victim->cached = false;
+        victim->texture.reset();
+        m_lazyCachedBytes -= victim->bytes;
+        m_lazyResidentBytes -= victim->bytes;
+
+        std::cout << "[ResourceManager] Evicted " << victim->key << " (on-demand textures: "
+                  << m_lazyResidentBytes / (1024 * 1024) << " MB)\n";
+    }
+}
+
+TextureHandle::TextureHandle(ResourceManager::LazyTexture* entry) :
+    m_entry(entry)
+{
+    if(m_entry) m_entry->refCount++;
+}
+
+TextureHandle::TextureHandle(const TextureHandle& other) :
+    m_entry(other.m_entry)
+{
+    if(m_entry) m_entry->refCount++;
+}
+
+TextureHandle::TextureHandle(TextureHandle&& other) noexcept :
+    m_entry(other.m_entry)
+{
+    other.m_entry = nullptr;
+}
+
+TextureHandle& TextureHandle::operator=(TextureHandle other)
+{
+    // Handle cũ được thả khi other bị hủy, sau khi đã giữ texture mới
+    std::swap(m_entry, other.m_entry);
+    return *this;
+}
+
+TextureHandle::~TextureHandle()
+{
+    if(m_entry) ResourceManager::getInstance().releaseTexture(*m_entry);
+}
+
+sf::Texture& TextureHandle::get() const
+{
+    assert(m_entry && m_entry->texture);
+    return *m_entry->texture;
 }
 
 void ResourceManager::loadFont(const std::string& key, const std::string& filePath)
 {
+    // Font đọc dần từ nguồn trong suốt thời gian dùng, vùng map của archive sống tới cuối chương trình
     sf::Font font;
-    if(!font.loadFromFile(filePath))
+    AssetArchive::Blob blob;
+    bool loaded = findPacked(filePath, blob) ? font.loadFromMemory(blob.data, blob.size) : font.loadFromFile(filePath);
+    if(!loaded)
     {
         std::cerr << "font " << key << " cannot load!\n";
         assert(false);
@@ -61,7 +546,9 @@ sf::Font& ResourceManager::getFont(const std::string& key)
 void ResourceManager::loadSoundBuffer(const std::string& key, const std::string& filePath)
 {
     sf::SoundBuffer buffer;
-    if(!buffer.loadFromFile(filePath))
+    AssetArchive::Blob blob;
+    bool loaded = findPacked(filePath, blob) ? buffer.loadFromMemory(blob.data, blob.size) : buffer.loadFromFile(filePath);
+    if(!loaded)
     {
         std::cerr << "buffer " << key << " cannot load!\n";
         assert(false);
@@ -123,7 +610,10 @@ void ResourceManager::playMusic(int themeIndex)
 
     std::cout << themeIndex << "\n";
 
-    if(m_backgroundMusic.openFromFile(filename))
+    AssetArchive::Blob blob;
+    bool opened = findPacked(filename, blob) ? m_backgroundMusic.openFromMemory(blob.data, blob.size)
+                                             : m_backgroundMusic.openFromFile(filename);
+    if(opened)
     {
         m_backgroundMusic.setLoop(true);
         m_backgroundMusic.play();
@@ -152,7 +642,10 @@ void ResourceManager::playAmbient(const std::string& filePath)
          return;
     }
 
-    if(m_ambientMusic.openFromFile(filePath))
+    AssetArchive::Blob blob;
+    bool opened = findPacked(filePath, blob) ? m_ambientMusic.openFromMemory(blob.data, blob.size)
+                                             : m_ambientMusic.openFromFile(filePath);
+    if(opened)
     {
         m_ambientMusic.setLoop(true);
         m_ambientMusic.play();
@@ -11,7 +11,7 @@ About::About(sf::RenderWindow& window)
     , m_scrollOffset(0.f)
     , m_maxScroll(0.f)
     , m_viewHeight(0.f)
-    , m_backBtn(ResourceManager::getInstance().getTexture("about_back_btn"), {62.f, 57.f}, true)
+    , m_backBtn(ResourceManager::getInstance().getRegion("about_back_btn"), {62.f, 57.f}, true)
 {
     createUI();
 }
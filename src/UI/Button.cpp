@@ -31,6 +31,18 @@ Button::Button(const sf::Texture& textureRef,
                    setPosition(position);
                }
 
+Button::Button(const TextureRegion& region,
+               const sf::Vector2f& position,
+               bool isInteractive):
+
+               Button(*region.texture, position, isInteractive)
+               {
+                   m_sprite.setTextureRect(region.rect);
+
+                   sf::FloatRect spriteSize = m_sprite.getLocalBounds();
+                   m_sprite.setOrigin(sf::Vector2f(spriteSize.width / 2.f, spriteSize.height / 2.f));
+               }
+
 void Button::setPosition(const sf::Vector2f& pos)
 {
     m_sprite.setPosition(pos);
@@ -24,20 +24,22 @@ GamePlay::GamePlay(sf::RenderWindow& window, int boardSize, GameMode mode, AiDif
     m_aiShouldMove(false),
     m_aiThinkTimer(0.f),
     m_gameHasEnded(false),
-    m_background(ResourceManager::getInstance().getTexture("gameplay_background")),
-    m_turnactionBackground(ResourceManager::getInstance().getTexture("gameplay_turnaction_background")),
-    m_logBackground(ResourceManager::getInstance().getTexture("gameplay_log_background")),
-    m_timerPanel(ResourceManager::getInstance().getTexture("gameplay_timer_bg")),
-    m_boardSprite(ResourceManager::getInstance().getTexture(GlobalSetting::getInstance().getBoardTextureKey(boardSize))),
-    m_blackStoneTex(&ResourceManager::getInstance().getTexture(GlobalSetting::getInstance().getStoneTextureKey(true, boardSize))),
-    m_whiteStoneTex(&ResourceManager::getInstance().getTexture(GlobalSetting::getInstance().getStoneTextureKey(false, boardSize))),
+    m_backgroundTexture(ResourceManager::getInstance().acquireTexture("gameplay_background")),
+    m_background(m_backgroundTexture.get()),
+    m_turnactionBackground(ResourceManager::getInstance().getRegion("gameplay_turnaction_background").makeSprite()),
+    m_logBackground(ResourceManager::getInstance().getRegion("gameplay_log_background").makeSprite()),
+    m_timerPanel(ResourceManager::getInstance().getRegion("gameplay_timer_bg").makeSprite()),
+    m_boardTexture(ResourceManager::getInstance().acquireTexture(GlobalSetting::getInstance().getBoardTextureKey(boardSize))),
+    m_boardSprite(m_boardTexture.get()),
+    m_blackStoneRegion(&ResourceManager::getInstance().getRegion(GlobalSetting::getInstance().getStoneTextureKey(true, boardSize))),
+    m_whiteStoneRegion(&ResourceManager::getInstance().getRegion(GlobalSetting::getInstance().getStoneTextureKey(false, boardSize))),
     m_font(ResourceManager::getInstance().getFont("main_font")),
-    m_pauseButton(ResourceManager::getInstance().getTexture("gameplay_pause_btn"), {1545.f, 55.f}, true),
-    m_passButton(ResourceManager::getInstance().getTexture("gameplay_pass_btn"), {1268.f, 175.f}, true),
-    m_undoBtn(ResourceManager::getInstance().getTexture("gameplay_undo_btn"), {1387.f, 175.f}, true),
-    m_redoBtn(ResourceManager::getInstance().getTexture("gameplay_redo_btn"), {1506.f, 175.f}, true),
-    m_resignButton(ResourceManager::getInstance().getTexture("gameplay_resign_btn"), {55.f, 55.f}, true),
-    m_hintButton(ResourceManager::getInstance().getTexture("gameplay_hint_btn"), {110.f, 55.f}, true),
+    m_pauseButton(ResourceManager::getInstance().getRegion("gameplay_pause_btn"), {1545.f, 55.f}, true),
+    m_passButton(ResourceManager::getInstance().getRegion("gameplay_pass_btn"), {1268.f, 175.f}, true),
+    m_undoBtn(ResourceManager::getInstance().getRegion("gameplay_undo_btn"), {1387.f, 175.f}, true),
+    m_redoBtn(ResourceManager::getInstance().getRegion("gameplay_redo_btn"), {1506.f, 175.f}, true),
+    m_resignButton(ResourceManager::getInstance().getRegion("gameplay_resign_btn"), {55.f, 55.f}, true),
+    m_hintButton(ResourceManager::getInstance().getRegion("gameplay_hint_btn"), {110.f, 55.f}, true),
     m_blackUsedHint(false),
     m_whiteUsedHint(false),
     m_hintCoord(-5, -5)
@@ -97,8 +99,8 @@ GamePlay::GamePlay(sf::RenderWindow& window, int boardSize, GameMode mode, AiDif
         sf::Vector2f(280.f, 563.f),
         ResourceManager::getInstance().getTexture("gameplay_historylist_background"),
         ResourceManager::getInstance().getTexture("gameplay_historylist_track"),
-        ResourceManager::getInstance().getTexture("gameplay_historylist_icon_black"),
-        ResourceManager::getInstance().getTexture("gameplay_historylist_icon_white"),
+        ResourceManager::getInstance().getRegion("gameplay_historylist_icon_black"),
+        ResourceManager::getInstance().getRegion("gameplay_historylist_icon_white"),
         ResourceManager::getInstance().getFont("main_font")
     );
 
@@ -116,7 +118,7 @@ GamePlay::GamePlay(sf::RenderWindow& window, int boardSize, GameMode mode, AiDif
 
     m_logBackground.setPosition(sf::Vector2f(520.f, 850));
 
-    m_loadingSprite.setTexture(ResourceManager::getInstance().getTexture("loading_icon"));
+    ResourceManager::getInstance().getRegion("loading_icon").applyTo(m_loadingSprite);
     bounds = m_loadingSprite.getLocalBounds();
     m_loadingSprite.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
     m_loadingSprite.setPosition(sf::Vector2f(675.f, 870.f));
@@ -138,14 +140,13 @@ GamePlay::GamePlay(sf::RenderWindow& window, int boardSize, GameMode mode, AiDif
 
     bounds = m_timerPanel.getLocalBounds();
     m_timerPanel.setOrigin(sf::Vector2f(bounds.width / 2.f, bounds.height / 2.f));
-    m_timerPanel.setTexture(ResourceManager::getInstance().getTexture("gameplay_timer_bg"));
     m_timerPanel.setPosition(1387.f, 343.f);
 
     std::string blackKey = GlobalSetting::getInstance().getStoneTextureKey(true, 19);
     std::string whiteKey = GlobalSetting::getInstance().getStoneTextureKey(false, 19);
 
-    m_timerIconBlack.setTexture(ResourceManager::getInstance().getTexture(blackKey));
-    m_timerIconWhite.setTexture(ResourceManager::getInstance().getTexture(whiteKey));
+    ResourceManager::getInstance().getRegion(blackKey).applyTo(m_timerIconBlack);
+    ResourceManager::getInstance().getRegion(whiteKey).applyTo(m_timerIconWhite);
 
     bounds = m_timerIconBlack.getLocalBounds();
     m_timerIconBlack.setOrigin(sf::Vector2f(bounds.width / 2.f, bounds.height / 2.f));
@@ -232,6 +233,9 @@ GamePlay::GamePlay(sf::RenderWindow& window, int boardSize, GameMode mode, AiDif
 
     m_moveTimer.restart();
 
+    m_botWorker = std::make_unique<ThreadPool>(1);
+    m_analysisWorker = std::make_unique<ThreadPool>(2);
+
     m_isScoringMode = false;
     m_scoringOverlay = std::make_unique<UI::ScoringOverlay>(
         m_boardSize, m_cellSpacing,
@@ -251,56 +255,61 @@ GamePlay::GamePlay(sf::RenderWindow& window, int boardSize, GameMode mode, AiDif
 
 void GamePlay::startGameInitialization()
 {
+    cancelAiMove();
     m_isInitializing = true;
     showMessage("Starting Engine...", MsgType::Info);
 
-    std::thread([this]()
-    {
-        std::lock_guard<std::mutex> lock(m_workerMutex);
+    // Bot mới được update() lấy từ BotManager khi khởi tạo xong; bot cũ chỉ còn được worker dùng
+    std::shared_ptr<IBot> oldBot = m_bot;
+    m_bot = nullptr;
+
+    int size = m_boardSize;
+    bool withBot = (m_mode == GameMode::PlayerVsAI);
+    AiDifficulty difficulty = m_difficulty;
+    auto board = m_logic.getBoard();
+    std::vector<GameMove> history = m_logic.getMoveHistory();
 
-        BotManager::getInstance().startBackgroundPachi(m_boardSize);
+    postBotTask(oldBot, [this, size, withBot, difficulty, board, history]()
+    {
+        BotManager::getInstance().getEnginePool().setPosition(size, {});
 
-        if(m_mode == GameMode::PlayerVsAI)
+        std::shared_ptr<IBot> bot;
+        if(withBot)
         {
-            BotManager::getInstance().startBot(m_difficulty, m_boardSize);
-            m_bot = BotManager::getInstance().getBot();
+            BotManager::getInstance().startBot(difficulty, size);
+            bot = BotManager::getInstance().getBot();
         }
         else
         {
-            m_bot = nullptr;
+            BotManager::getInstance().stopBot();
         }
 
-        performSyncBoardInternal();
+        performSyncBoardInternal(bot, size, board, history);
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(1400));
+        for(int i = 0; i < 14 && !m_closing; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
 
         m_isInitializing = false;
-
-    }).detach();
+    });
 }
 
-void GamePlay::performSyncBoardInternal()
+void GamePlay::performSyncBoardInternal(const std::shared_ptr<IBot>& oppBot, int size,
+                                        const std::vector<std::vector<StoneType>>& board, const std::vector<GameMove>& history)
 {
-    auto board = m_logic.getBoard();
-    int size = m_boardSize;
-
-    auto bgBot = BotManager::getInstance().getBackgroundBot();
-    auto oppBot = m_bot;
-
     auto resetSingleBot = [&](std::shared_ptr<IBot> bot)
     {
         if(!bot) return;
         if(auto pachi = std::dynamic_pointer_cast<PachiBot>(bot))
         {
-            pachi->sendCommand("clear_board");
-            pachi->setBoardSize(size);
-            pachi->sendCommand("boardsize " + std::to_string(size));
-        }
-        else
-        {
-            bot->init();
+            // Engine nhớ các nước đã nhận: sau undo/redo chỉ gửi undo + các nước khác nhau
+            pachi->syncPosition(size, history);
+            return;
         }
 
+        bot->init();
+
         for(int y = 0; y < size; ++y)
         {
             for(int x = 0; x < size; ++x)
@@ -314,11 +323,10 @@ void GamePlay::performSyncBoardInternal()
         }
     };
 
-    resetSingleBot(bgBot);
-    if(oppBot && oppBot != bgBot)
-    {
-        resetSingleBot(oppBot);
-    }
+    resetSingleBot(oppBot);
+
+    // Các engine trong pool được đồng bộ lại khi được mượn ra
+    BotManager::getInstance().getEnginePool().setPosition(size, history);
 
     std::cout << "[GamePlay] Board synced to bots successfully.\n";
 }
@@ -331,24 +339,22 @@ void GamePlay::updateThemeResources()
 
     std::string blackKey = gs.getStoneTextureKey(true, boardSize);
     std::string whiteKey = gs.getStoneTextureKey(false, boardSize);
-    m_blackStoneTex = &res.getTexture(blackKey);
-    m_whiteStoneTex = &res.getTexture(whiteKey);
-
-    m_timerIconBlack.setTexture(*m_blackStoneTex);
-    m_timerIconWhite.setTexture(*m_whiteStoneTex);
+    m_blackStoneRegion = &res.getRegion(blackKey);
+    m_whiteStoneRegion = &res.getRegion(whiteKey);
 
     blackKey = gs.getStoneTextureKey(true, 19);
     whiteKey = gs.getStoneTextureKey(false, 19);
 
-    m_timerIconBlack.setTexture(res.getTexture(blackKey));
-    m_timerIconWhite.setTexture(res.getTexture(whiteKey));
+    res.getRegion(blackKey).applyTo(m_timerIconBlack);
+    res.getRegion(whiteKey).applyTo(m_timerIconWhite);
 
     std::string boardKey = gs.getBoardTextureKey(boardSize);
-    m_boardSprite.setTexture(res.getTexture(boardKey));
+    m_boardTexture = res.acquireTexture(boardKey);
+    m_boardSprite.setTexture(m_boardTexture.get());
 
     if(m_historyList)
     {
-        m_historyList->updateTheme(&res.getTexture(gs.getStoneTextureKey(true, 13)), &res.getTexture(gs.getStoneTextureKey(false, 13)));
+        m_historyList->updateTheme(&res.getRegion(gs.getStoneTextureKey(true, 13)), &res.getRegion(gs.getStoneTextureKey(false, 13)));
     }
 
     m_soundCaptureBlack.stop(); m_soundCaptureWhite.stop();
@@ -398,70 +404,111 @@ void GamePlay::updateThemeResources()
 
 void GamePlay::requestHintFromBot()
 {
-    auto hintBot = BotManager::getInstance().getBackgroundBot();
-    if(!hintBot && std::dynamic_pointer_cast<PachiBot>(m_bot))
-        hintBot = std::dynamic_pointer_cast<PachiBot>(m_bot);
+    m_isCalculatingHint = true;
+    showMessage("Analyzing position...", MsgType::Info);
 
-    if(hintBot)
+    bool isBlack = m_logic.isBlacksTurn();
+
+    m_analysisWorker->submit([this, isBlack]()
     {
-        m_isCalculatingHint = true;
-        showMessage("Analyzing position...", MsgType::Info);
+        if(m_closing) return;
 
-        bool isBlack = m_logic.isBlacksTurn();
-        auto currentBoard = m_logic.getBoard();
-        int boardSize = m_boardSize;
+        EnginePool::Lease hintBot = BotManager::getInstance().getEnginePool().checkout();
 
-        std::thread([this, hintBot, isBlack, currentBoard, boardSize]()
+        hintBot->setTimeSettings(0, 8, 1);
         {
-            std::lock_guard<std::mutex> lock(m_workerMutex);
+            std::lock_guard<std::mutex> lock(m_hintEngineMutex);
+            m_hintEngine = hintBot.bot();
+        }
 
-            auto pachi = std::dynamic_pointer_cast<PachiBot>(hintBot);
-            if(pachi)
-            {
-                pachi->sendCommand("time_settings 0 8 1");
-            }
-            else
-            {
-                hintBot->init();
-            }
+        // Đóng màn hình trước lúc m_hintEngine được gán thì ~GamePlay không ngắt được, nên kiểm tra lại
+        BotMove move;
+        if(!m_closing) move = hintBot->suggestMove(isBlack);
 
-            BotMove move = hintBot->generateMove(isBlack);
+        {
+            std::lock_guard<std::mutex> lock(m_hintEngineMutex);
+            m_hintEngine.reset();
+        }
 
-            if(pachi)
-            {
-                pachi->sendCommand("undo");
+        // Trả engine về thời gian mặc định của pool trước khi người khác mượn
+        hintBot->setTimeSettings(0, 1, 1);
+        hintBot.release();
 
-                if(m_mode == GameMode::PlayerVsAI)
-                {
-                    if(m_difficulty == AiDifficulty::Hard)
-                        pachi->sendCommand("time_settings 0 8 1");
-                    else if(m_difficulty == AiDifficulty::Medium)
-                        pachi->sendCommand("time_settings 0 4 1");
-                    else
-                        pachi->sendCommand("time_settings 0 1 1");
-                }
-                else
-                {
-                    pachi->sendCommand("time_settings 0 1 1");
-                }
-            }
+        if(m_closing) return;
 
-            if(move.isResign)
-            {
-                m_hintCoord = {-2, -2};
-            }
-            else if(move.isPass)
-            {
-                m_hintCoord = {-1, -1};
-            }
-            else
+        if(move.isResign)
+        {
+            m_hintCoord = {-2, -2};
+        }
+        else if(move.isPass)
+        {
+            m_hintCoord = {-1, -1};
+        }
+        else
+        {
+            m_hintCoord = {move.x, move.y};
+        }
+
+        m_isCalculatingHint = false;
+    });
+}
+
+void GamePlay::requestDeadStones()
+{
+    m_isCalculatingScore = true;
+
+    // Mượn engine rảnh trong pool trên m_analysisWorker: có thể phải chờ engine khởi động hoặc đồng bộ lại
+    m_analysisWorker->submit([this]()
+    {
+        if(m_closing) return;
+
+        EnginePool::Lease scoringBot = BotManager::getInstance().getEnginePool().checkout();
+
+        std::vector<BoardPoint> deadStones;
+        if(scoringBot && !m_closing) deadStones = scoringBot->getDeadStones();
+        scoringBot.release();
+
+        if(m_closing) return;
+
+        m_scoredDeadStones = deadStones;
+        m_isCalculatingScore = false;
+    });
+}
+
+void GamePlay::applyDeadStones()
+{
+    // Ván đã được undo trong lúc tính thì bỏ kết quả
+    if(!m_gameHasEnded) return;
+
+    m_deadStones = m_scoredDeadStones;
+
+    std::vector<DeadStoneInfo> displayStones;
+    auto currentBoard = m_logic.getBoard();
+    for(const auto& p : m_deadStones)
+    {
+        if(p.x >= 0 && p.x < m_boardSize && p.y >= 0 && p.y < m_boardSize)
+        {
+            StoneType type = currentBoard[p.y][p.x];
+            TerritoryOwner owner = TerritoryOwner::Neutral;
+
+            if(type == StoneType::Black)       owner = TerritoryOwner::Black;
+            else if(type == StoneType::White) owner = TerritoryOwner::White;
+
+            if(owner != TerritoryOwner::Neutral)
             {
-                m_hintCoord = {move.x, move.y};
+                displayStones.push_back({ p, owner });
             }
+        }
+    }
+
+    std::vector<TerritoryRegion> regions = m_logic.getTerritoryRegions(m_deadStones);
 
-            m_isCalculatingHint = false;
+    finalizeScore();
 
-        }).detach();
+    m_isScoringMode = true;
+    if(m_scoringOverlay)
+    {
+        m_scoringOverlay->startAnimation(regions, displayStones);
     }
 }
 
@@ -532,35 +579,46 @@ void GamePlay::handleEvent(sf::Event& event)
     }
 }
 
-void GamePlay::syncToAllBots(const std::string& color, int x, int y)
+void GamePlay::postBotTask(const std::shared_ptr<IBot>& bot, std::function<void()> task)
 {
-    std::thread([this, color, x, y]()
+    m_botWorker->submit([this, bot, task]()
     {
-        std::lock_guard<std::mutex> lock(m_workerMutex);
-
-        if(m_bot)
+        // Chờ lượt genmove đã hủy dừng hẳn (Pachi bị kill nên chỉ vài trăm ms) trên worker, không phải trên luồng UI
+        while(bot && !bot->waitIdleFor(100))
         {
-            m_bot->syncMove(color, x, y);
+            if(m_closing) return;
         }
+        if(m_closing) return;
 
-        auto bgBot = BotManager::getInstance().getBackgroundBot();
+        task();
+    });
+}
 
-        if(bgBot && bgBot != m_bot)
+void GamePlay::syncToAllBots(const std::string& color, int x, int y)
+{
+    if(m_bot)
+    {
+        std::shared_ptr<IBot> bot = m_bot;
+        postBotTask(bot, [bot, color, x, y]()
         {
-            bgBot->syncMove(color, x, y);
-        }
+            bot->syncMove(color, x, y);
+        });
+    }
 
-    }).detach();
+    BotManager::getInstance().getEnginePool().pushMove(color == "black", x, y);
 }
 
 void GamePlay::fullResyncBots()
 {
-    std::thread t([this]()
+    std::shared_ptr<IBot> bot = m_bot;
+    int size = m_boardSize;
+    auto board = m_logic.getBoard();
+    std::vector<GameMove> history = m_logic.getMoveHistory();
+
+    postBotTask(bot, [this, bot, size, board, history]()
     {
-        std::lock_guard<std::mutex> lock(m_workerMutex);
-        performSyncBoardInternal();
+        performSyncBoardInternal(bot, size, board, history);
     });
-    t.detach();
 }
 
 void GamePlay::placeMessageText(sf::Text& m_messageText)
@@ -586,7 +644,7 @@ GameStateType GamePlay::update(float deltaTime)
         m_scoringOverlay->update(deltaTime);
     }
 
-    bool isBusy = m_isAiThinkingWorker || m_isCalculatingHint || m_isInitializing;
+    bool isBusy = m_isAiThinkingWorker || m_isCalculatingHint || m_isInitializing || m_isCalculatingScore;
 
     if(isBusy)
     {
@@ -616,26 +674,7 @@ GameStateType GamePlay::update(float deltaTime)
         bool isScoring = (m_endReason.find("SCORING") != std::string::npos);
         if(m_gameHasEnded && isScoring)
         {
-            auto bgBot = BotManager::getInstance().getBackgroundBot();
-            if(bgBot) m_deadStones = bgBot->getDeadStones();
-
-            finalizeScore();
-
-            std::vector<DeadStoneInfo> displayStones;
-            auto currentBoard = m_logic.getBoard();
-            for(const auto& p : m_deadStones)
-            {
-                if(p.x >= 0 && p.x < m_boardSize && p.y >= 0 && p.y < m_boardSize)
-                {
-                    StoneType type = currentBoard[p.y][p.x];
-                    TerritoryOwner owner = (type == StoneType::Black) ? TerritoryOwner::Black : TerritoryOwner::White;
-                    displayStones.push_back({ p, owner });
-                }
-            }
-            std::vector<TerritoryRegion> regions = m_logic.getTerritoryRegions(m_deadStones);
-
-            m_isScoringMode = true;
-            if(m_scoringOverlay) m_scoringOverlay->startAnimation(regions, displayStones);
+            requestDeadStones();
         }
 
         if(m_mode == GameMode::PlayerVsAI && m_bot && !m_logic.isBlacksTurn())
@@ -664,6 +703,13 @@ GameStateType GamePlay::update(float deltaTime)
     }
     wasCalculatingHint = m_isCalculatingHint;
 
+    static bool wasCalculatingScore = false;
+    if(wasCalculatingScore && !m_isCalculatingScore)
+    {
+        applyDeadStones();
+    }
+    wasCalculatingScore = m_isCalculatingScore;
+
     if(m_messageTimer > 0.f)
     {
         m_messageTimer -= deltaTime;
@@ -789,22 +835,26 @@ GameStateType GamePlay::update(float deltaTime)
             bool aiIsBlack = m_logic.isBlacksTurn();
             m_moveTimer.restart();
 
-            PendingMove userMove = m_pendingPlayerMove;
             m_pendingPlayerMove.active = false;
 
-            m_aiFuture = std::async(std::launch::async, [this, aiIsBlack, userMove]()
+            std::cout << "[AI] Calling generateMove()...\n";
+            std::shared_ptr<IBot> bot = m_bot;
+            int turnId;
             {
-                if(!m_bot) return BotMove();
-                std::cout << "[AI] Calling generateMove()...\n";
-                BotMove move = m_bot->generateMove(aiIsBlack);
-                return move;
+                std::lock_guard<std::mutex> lock(m_aiTurnMutex);
+                turnId = m_aiTurnId;
+            }
+            postBotTask(bot, [this, bot, aiIsBlack, turnId]()
+            {
+                std::lock_guard<std::mutex> lock(m_aiTurnMutex);
+                if(turnId == m_aiTurnId) bot->startMove(aiIsBlack);
             });
         }
         else
         {
-            if(m_aiFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            BotMove move;
+            if(m_bot->pollMove(move))
             {
-                BotMove move = m_aiFuture.get();
                 m_isAiThinkingWorker = false;
                 m_aiShouldMove = false;
 
@@ -847,8 +897,7 @@ GameStateType GamePlay::update(float deltaTime)
                         }
                         else
                         {
-                            auto bgBot = BotManager::getInstance().getBackgroundBot();
-                            if(bgBot && bgBot != m_bot) bgBot->syncMove(aiColorStr, move.x, move.y);
+                            BotManager::getInstance().getEnginePool().pushMove(aiColorIsBlack, move.x, move.y);
                         }
 
                         m_historyList->addMove(aiColorIsBlack, notation);
@@ -920,7 +969,7 @@ void GamePlay::draw()
         {
             sf::Sprite ghostSprite;
             bool isBlack = m_logic.isBlacksTurn();
-            ghostSprite.setTexture(isBlack ? *m_blackStoneTex : *m_whiteStoneTex);
+            (isBlack ? m_blackStoneRegion : m_whiteStoneRegion)->applyTo(ghostSprite);
 
             ghostSprite.setColor(sf::Color(255, 255, 255, 120));
 
@@ -960,51 +1009,39 @@ void GamePlay::draw()
 
 void GamePlay::drawStones()
 {
-    sf::Sprite stoneSprite;
-
-    std::vector < std::vector<bool> > isDeadStone(m_boardSize, std::vector<bool>(m_boardSize, false));
-    for(auto &p : m_deadStones) isDeadStone[p.y][p.x] = true;
+    m_stoneLayer.setTextures(*m_blackStoneRegion, *m_whiteStoneRegion);
+    m_stoneLayer.setLayout(m_boardSize, m_boardTopLeftX, m_boardTopLeftY, m_cellSpacing);
 
     for(int y = 0; y < m_boardSize; ++y)
     {
-        for(int x = 0; x < m_boardSize; ++x) if(!isDeadStone[y][x])
+        for(int x = 0; x < m_boardSize; ++x)
         {
             StoneType stone = m_logic.getStoneAt(x, y);
-            if(stone == StoneType::Empty && (y != m_hintCoord.y || x != m_hintCoord.x)) continue;
+            sf::Uint8 alpha = 255;
             if(y == m_hintCoord.y && x == m_hintCoord.x)
             {
                 stone = (m_logic.isBlacksTurn() ? StoneType::Black : StoneType::White);
+                alpha = 100;
             }
 
-            stoneSprite.setTexture((stone == StoneType::Black) ? *m_blackStoneTex : *m_whiteStoneTex);
-            sf::FloatRect texBounds = stoneSprite.getLocalBounds();
-            stoneSprite.setOrigin(texBounds.width / 2.f, texBounds.height / 2.f);
-
-            float currentScale = m_stoneScaleMatrix[y][x];
-            stoneSprite.setScale(currentScale, currentScale);
-
-            stoneSprite.setPosition(std::round(m_boardTopLeftX + (x * m_cellSpacing)), std::round(m_boardTopLeftY + (y * m_cellSpacing)));
-
-            if(y == m_hintCoord.y && x == m_hintCoord.x)
-            {
-                stoneSprite.setColor(sf::Color(255, 255, 255, 100));
-            }
-            else
-            {
-                stoneSprite.setColor(sf::Color::White);
-            }
+            m_stoneLayer.setStone(x, y, stone, m_stoneScaleMatrix[y][x], alpha);
+        }
+    }
 
-            m_window.draw(stoneSprite);
+    // Quân chết do ScoringOverlay vẽ
+    for(auto &p : m_deadStones) m_stoneLayer.setStone(p.x, p.y, StoneType::Empty, 1.f);
 
-            auto &gs = GlobalSetting::getInstance();
-            if(x == m_lastMoveCoord.x && y == m_lastMoveCoord.y && gs.stoneThemeIndex == 0)
-            {
-                m_lastMoveMarker.setScale(currentScale, currentScale);
-                m_lastMoveMarker.setPosition(std::round(m_boardTopLeftX + (x * m_cellSpacing)), std::round(m_boardTopLeftY + (y * m_cellSpacing)));
-                m_window.draw(m_lastMoveMarker);
-            }
-        }
+    if(GlobalSetting::getInstance().stoneThemeIndex == 0)
+    {
+        m_stoneLayer.setLastMoveMarker(m_lastMoveCoord.x, m_lastMoveCoord.y, m_lastMoveMarker.getSize().x, m_lastMoveMarker.getFillColor());
     }
+    else
+    {
+        m_stoneLayer.setLastMoveMarker(-1, -1, 0.f, m_lastMoveMarker.getFillColor());
+    }
+
+    m_stoneLayer.rebuildIfNeeded();
+    m_window.draw(m_stoneLayer);
 }
 
 void GamePlay::onBoardClick(int mouseX, int mouseY)
@@ -1082,16 +1119,7 @@ void GamePlay::onBoardClick(int mouseX, int mouseY)
 
         std::string colorStr = isBlackMove ? "black" : "white";
 
-        if(m_bot)
-        {
-            m_bot->syncMove(colorStr, x, y);
-        }
-
-        auto bgBot = BotManager::getInstance().getBackgroundBot();
-        if(bgBot && bgBot != m_bot)
-        {
-            bgBot->syncMove(colorStr, x, y);
-        }
+        syncToAllBots(colorStr, x, y);
 
         if(m_bot && m_mode == GameMode::PlayerVsAI && BotManager::getInstance().isReady())
         {
@@ -1116,10 +1144,45 @@ void GamePlay::onBoardClick(int mouseX, int mouseY)
     }
 }
 
+GamePlay::~GamePlay()
+{
+    m_closing = true;
+    cancelAiMove();
+
+    // Việc còn trong hàng đợi thấy m_closing và bỏ qua; chỉ chờ việc đang chạy dở
+    m_botWorker.reset();
+
+    {
+        std::lock_guard<std::mutex> lock(m_hintEngineMutex);
+        if(m_hintEngine) m_hintEngine->abortSearch();
+    }
+    m_analysisWorker.reset();
+
+    BotManager::getInstance().stopBot();
+}
+
+bool GamePlay::cancelAiMove()
+{
+    bool droppedResult = false;
+    {
+        std::lock_guard<std::mutex> lock(m_aiTurnMutex);
+        m_aiTurnId++;
+        if(m_isAiThinkingWorker && m_bot)
+        {
+            droppedResult = m_bot->cancelMove();
+        }
+    }
+    m_isAiThinkingWorker = false;
+    m_aiShouldMove = false;
+    return droppedResult;
+}
+
 void GamePlay::onResignClick()
 {
     if(m_gameHasEnded || m_isScoringMode) return;
 
+    cancelAiMove();
+
     bool isBlackTurn = m_logic.isBlacksTurn();
     std::string msg;
     bool blackWins;
@@ -1199,6 +1262,7 @@ void GamePlay::onPassClick(bool isBotAction)
     bool currentTurnIsBlack = m_logic.isBlacksTurn();
 
     MoveResult result = m_logic.attemptPass();
+    BotManager::getInstance().getEnginePool().pushMove(currentTurnIsBlack, -1, -1);
 
     float thinkingTime = isBotAction ? 1.0f : m_moveTimer.restart().asSeconds();
 
@@ -1229,44 +1293,8 @@ void GamePlay::onPassClick(bool isBotAction)
         m_gameOverText.setOrigin(textBounds.left + textBounds.width / 2.f, textBounds.top + textBounds.height / 2.f);
         m_gameOverText.setPosition(m_window.getSize().x / 2.f, m_window.getSize().y / 2.f);
 
-        auto scoringBot = BotManager::getInstance().getBackgroundBot();
-        std::shared_ptr<IBot> finalBot = scoringBot;
-
-        std::vector <DeadStoneInfo> displayStones;
-        displayStones.clear();
-
-        if(finalBot)
-        {
-            m_deadStones = finalBot->getDeadStones();
-            auto currentBoard = m_logic.getBoard();
-
-            for(const auto& p : m_deadStones)
-            {
-                if(p.x >= 0 && p.x < m_boardSize && p.y >= 0 && p.y < m_boardSize)
-                {
-                    StoneType type = currentBoard[p.y][p.x];
-                    TerritoryOwner owner = TerritoryOwner::Neutral;
-
-                    if(type == StoneType::Black)       owner = TerritoryOwner::Black;
-                    else if(type == StoneType::White) owner = TerritoryOwner::White;
-
-                    if(owner != TerritoryOwner::Neutral)
-                    {
-                        displayStones.push_back({ p, owner });
-                    }
-                }
-            }
-        }
-
-        std::vector<TerritoryRegion> regions = m_logic.getTerritoryRegions(m_deadStones);
-
-        finalizeScore();
-
-        m_isScoringMode = true;
-        if(m_scoringOverlay)
-        {
-            m_scoringOverlay->startAnimation(regions, displayStones);
-        }
+        // Mượn engine rảnh trong pool, không phải chờ engine của đối thủ; kết quả áp ở update()
+        requestDeadStones();
 
         m_turnText.setString("");
         placeMessageText(m_messageText);
@@ -1286,6 +1314,10 @@ void GamePlay::onPassClick(bool isBotAction)
 
 void GamePlay::onUndoClick()
 {
+    // Bot đang nghĩ: hủy lượt tìm kiếm rồi chỉ gỡ nước vừa đi của người chơi
+    bool botWasThinking = (m_mode == GameMode::PlayerVsAI && m_isAiThinkingWorker);
+    bool droppedBotMove = botWasThinking && cancelAiMove();
+
     if(m_mode == GameMode::PlayerVsAI && m_aiShouldMove) return;
 
     auto performSingleUndo = [&]()
@@ -1305,13 +1337,18 @@ void GamePlay::onUndoClick()
         return true;
     };
 
-    if(m_mode == GameMode::PlayerVsAI)
+    int undoneMoves = 0;
+    if(m_mode == GameMode::PlayerVsAI && !botWasThinking)
     {
-        if(performSingleUndo()) performSingleUndo();
+        if(performSingleUndo())
+        {
+            undoneMoves++;
+            if(performSingleUndo()) undoneMoves++;
+        }
     }
     else
     {
-        performSingleUndo();
+        if(performSingleUndo()) undoneMoves++;
     }
 
     if(m_gameHasEnded) m_gameHasEnded = false;
@@ -1320,19 +1357,25 @@ void GamePlay::onUndoClick()
 
     updateLastMoveMarkerFromHistory();
 
-    std::thread([this]()
+    // Lượt của bot đã xong nhưng chưa kịp lên bàn UI: nước đó đã nằm trên bàn của engine,
+    // nên đồng bộ lại cả bàn thay vì chỉ gỡ số nước UI vừa gỡ
+    if(droppedBotMove)
     {
-        std::lock_guard<std::mutex> lock(m_workerMutex);
-
-        if(auto pachi = std::dynamic_pointer_cast<PachiBot>(m_bot)) pachi->sendCommand("undo");
-
-        auto bgBot = BotManager::getInstance().getBackgroundBot();
-        if(bgBot && bgBot != m_bot)
+        fullResyncBots();
+    }
+    // Nước của lượt bị hủy khi đang chạy (nếu engine đã kịp đặt) được PachiBot tự gỡ trước khi việc này chạy
+    else if(auto pachi = std::dynamic_pointer_cast<PachiBot>(m_bot))
+    {
+        postBotTask(pachi, [pachi, undoneMoves]()
         {
-             bgBot->sendCommand("undo");
-        }
+            for(int i = 0; i < undoneMoves; ++i) pachi->undoMove();
+        });
+    }
 
-    }).detach();
+    for(int i = 0; i < undoneMoves; ++i)
+    {
+        BotManager::getInstance().getEnginePool().popMove();
+    }
 }
 
 void GamePlay::onRedoClick()
@@ -1429,7 +1472,7 @@ void GamePlay::saveThumbnail(const std::string& filename)
     float scaledPaddingBot = originalPaddingBot * scaleFactor;
     float scaledBoardWidth = 400.f - (scaledPaddingTop + scaledPaddingBot);
     float scaledCellSpace = scaledBoardWidth / (m_boardSize - 1);
-    float stoneScale = (scaledCellSpace / m_blackStoneTex->getSize().x) * 0.95f;
+    float stoneScale = (scaledCellSpace / m_blackStoneRegion->rect.width) * 0.95f;
 
     for(int y = 0; y < m_boardSize; ++y)
     {
@@ -1438,7 +1481,7 @@ void GamePlay::saveThumbnail(const std::string& filename)
             StoneType s = m_logic.getStoneAt(x, y);
             if(s == StoneType::Empty) continue;
 
-            stoneCopy.setTexture((s == StoneType::Black) ? *m_blackStoneTex : *m_whiteStoneTex);
+            ((s == StoneType::Black) ? m_blackStoneRegion : m_whiteStoneRegion)->applyTo(stoneCopy);
             sf::FloatRect bounds = stoneCopy.getLocalBounds();
             stoneCopy.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
             stoneCopy.setScale(stoneScale, stoneScale);
@@ -1479,9 +1522,10 @@ void GamePlay::performLoadGame(const std::string& filePath)
         auto &gs = GlobalSetting::getInstance();
         auto &res = ResourceManager::getInstance();
 
-        m_boardSprite.setTexture(ResourceManager::getInstance().getTexture(gs.getBoardTextureKey(m_boardSize)));
-        m_blackStoneTex = &res.getTexture(gs.getStoneTextureKey(true, m_boardSize));
-        m_whiteStoneTex = &res.getTexture(gs.getStoneTextureKey(false, m_boardSize));
+        m_boardTexture = res.acquireTexture(gs.getBoardTextureKey(m_boardSize));
+        m_boardSprite.setTexture(m_boardTexture.get());
+        m_blackStoneRegion = &res.getRegion(gs.getStoneTextureKey(true, m_boardSize));
+        m_whiteStoneRegion = &res.getRegion(gs.getStoneTextureKey(false, m_boardSize));
 
         float boardDisplaySize = 740.f;
         float paddingTop = 80.f;
@@ -1513,8 +1557,8 @@ void GamePlay::performLoadGame(const std::string& filePath)
             std::string blackKey = GlobalSetting::getInstance().getStoneTextureKey(true, 19);
             std::string whiteKey = GlobalSetting::getInstance().getStoneTextureKey(false, 19);
 
-            m_timerIconBlack.setTexture(ResourceManager::getInstance().getTexture(blackKey));
-            m_timerIconWhite.setTexture(ResourceManager::getInstance().getTexture(whiteKey));
+            ResourceManager::getInstance().getRegion(blackKey).applyTo(m_timerIconBlack);
+            ResourceManager::getInstance().getRegion(whiteKey).applyTo(m_timerIconWhite);
         }
         else
         {
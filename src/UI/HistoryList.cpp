@@ -16,15 +16,15 @@ const float TEXT_OFFSET_X = 130.f;
 HistoryList::HistoryList(sf::Vector2f position, sf::Vector2f size,
                          const sf::Texture& bgTex,
                          const sf::Texture& sliderTrack,
-                         const sf::Texture& blackIconTex,
-                         const sf::Texture& whiteIconTex,
+                         const TextureRegion& blackIcon,
+                         const TextureRegion& whiteIcon,
                          const sf::Font& font) :
     m_position(position),
     m_size(size),
     m_totalContentHeight(0.f),
     m_isScrollbarVisible(false),
-    m_blackStoneTex(&blackIconTex),
-    m_whiteStoneTex(&whiteIconTex),
+    m_blackStoneIcon(&blackIcon),
+    m_whiteStoneIcon(&whiteIcon),
     m_font(font)
 {
     m_background.setTexture(bgTex);
@@ -137,7 +137,7 @@ void HistoryList::addMove(bool isBlack, const std::string& moveCoords)
     newEntry.indexText.setCharacterSize(16);
     newEntry.indexText.setFillColor(sf::Color(70, 70, 70));
 
-    newEntry.stoneIcon.setTexture(isBlack ? *m_blackStoneTex : *m_whiteStoneTex);
+    (isBlack ? m_blackStoneIcon : m_whiteStoneIcon)->applyTo(newEntry.stoneIcon);
 
     newEntry.moveText.setFont(m_font);
     newEntry.moveText.setString(moveCoords);
@@ -170,17 +170,17 @@ void HistoryList::addMove(bool isBlack, const std::string& moveCoords)
     }
 }
 
-void HistoryList::updateTheme(const sf::Texture* blackTex, const sf::Texture* whiteTex)
+void HistoryList::updateTheme(const TextureRegion* blackIcon, const TextureRegion* whiteIcon)
 {
-    m_blackStoneTex = blackTex;
-    m_whiteStoneTex = whiteTex;
+    m_blackStoneIcon = blackIcon;
+    m_whiteStoneIcon = whiteIcon;
 
     for(auto& entry : m_entries)
     {
         if(entry.isBlack)
-            entry.stoneIcon.setTexture(*m_blackStoneTex);
+            m_blackStoneIcon->applyTo(entry.stoneIcon);
         else
-            entry.stoneIcon.setTexture(*m_whiteStoneTex);
+            m_whiteStoneIcon->applyTo(entry.stoneIcon);
 
         sf::FloatRect iconBounds = entry.stoneIcon.getLocalBounds();
         entry.stoneIcon.setOrigin(iconBounds.width / 2.f, iconBounds.height / 2.f);
@@ -0,0 +1,66 @@
+#include "LoadingScreen.h"
+#include <string>
+
+const float BAR_WIDTH = 600.f;
+const float BAR_HEIGHT = 14.f;
+const int UPLOAD_BUDGET_MS = 8;   // thời gian tạo texture tối đa mỗi frame, giữ 60 fps khi đang tải
+
+LoadingScreen::LoadingScreen(sf::RenderWindow& window) :
+    m_window(window)
+{
+    createUI();
+}
+
+void LoadingScreen::createUI()
+{
+    auto& rm = ResourceManager::getInstance();
+    sf::Vector2f center(m_window.getSize().x / 2.f, m_window.getSize().y / 2.f);
+
+    m_titleText.setFont(rm.getFont("title_font"));
+    m_titleText.setString("Go Game");
+    m_titleText.setCharacterSize(64);
+    m_titleText.setFillColor(sf::Color(230, 220, 200));
+    sf::FloatRect titleBounds = m_titleText.getLocalBounds();
+    m_titleText.setOrigin(titleBounds.left + titleBounds.width / 2.f, titleBounds.top + titleBounds.height / 2.f);
+    m_titleText.setPosition(center.x, center.y - 80.f);
+
+    m_barBackground.setSize({BAR_WIDTH, BAR_HEIGHT});
+    m_barBackground.setOrigin(BAR_WIDTH / 2.f, BAR_HEIGHT / 2.f);
+    m_barBackground.setPosition(center);
+    m_barBackground.setFillColor(sf::Color(60, 60, 60));
+    m_barBackground.setOutlineThickness(2.f);
+    m_barBackground.setOutlineColor(sf::Color(120, 110, 90));
+
+    m_barFill.setSize({0.f, BAR_HEIGHT});
+    m_barFill.setPosition(center.x - BAR_WIDTH / 2.f, center.y - BAR_HEIGHT / 2.f);
+    m_barFill.setFillColor(sf::Color(210, 170, 90));
+
+    m_percentText.setFont(rm.getFont("main_font"));
+    m_percentText.setCharacterSize(20);
+    m_percentText.setFillColor(sf::Color(200, 200, 200));
+    m_percentText.setPosition(center.x - BAR_WIDTH / 2.f, center.y + 20.f);
+}
+
+void LoadingScreen::handleEvent(sf::Event& event)
+{
+}
+
+GameStateType LoadingScreen::update(float deltaTime)
+{
+    auto& rm = ResourceManager::getInstance();
+    bool done = rm.updateLoading(sf::milliseconds(UPLOAD_BUDGET_MS));
+
+    float progress = rm.getLoadingProgress();
+    m_barFill.setSize({BAR_WIDTH * progress, BAR_HEIGHT});
+    m_percentText.setString("Loading... " + std::to_string((int)(progress * 100.f)) + "%");
+
+    return done ? GameStateType::MainMenu : GameStateType::NoChange;
+}
+
+void LoadingScreen::draw()
+{
+    m_window.draw(m_titleText);
+    m_window.draw(m_barBackground);
+    m_window.draw(m_barFill);
+    m_window.draw(m_percentText);
+}
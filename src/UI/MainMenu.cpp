@@ -11,14 +11,15 @@ const float BOUNCE_DURATION = 0.1f;
 MainMenu::MainMenu(sf::RenderWindow& window) :
     m_window(window),
     m_requestedState(GameStateType::NoChange),
-    m_backgroundSprite(ResourceManager::getInstance().getTexture("mainmenu_background")),
+    m_backgroundTexture(ResourceManager::getInstance().acquireTexture("mainmenu_background")),
+    m_backgroundSprite(m_backgroundTexture.get()),
 
-    m_NewGameBtn(ResourceManager::getInstance().getTexture("mainmenu_newgame_btn"), {476.f, 660.f}, true),
-    m_SavedGameBtn(ResourceManager::getInstance().getTexture("mainmenu_savedgame_btn"), {800.f, 660.f}, true),
-    m_SettingBtn(ResourceManager::getInstance().getTexture("mainmenu_setting_btn"), {1124.f, 660.f}, true),
+    m_NewGameBtn(ResourceManager::getInstance().getRegion("mainmenu_newgame_btn"), {476.f, 660.f}, true),
+    m_SavedGameBtn(ResourceManager::getInstance().getRegion("mainmenu_savedgame_btn"), {800.f, 660.f}, true),
+    m_SettingBtn(ResourceManager::getInstance().getRegion("mainmenu_setting_btn"), {1124.f, 660.f}, true),
 
-    m_ExitBtn(ResourceManager::getInstance().getTexture("mainmenu_quit_btn"), {1543.f, 57.f}, true),
-    m_AboutBtn(ResourceManager::getInstance().getTexture("mainmenu_about_btn"), {1423.f, 60.f}, true)
+    m_ExitBtn(ResourceManager::getInstance().getRegion("mainmenu_quit_btn"), {1543.f, 57.f}, true),
+    m_AboutBtn(ResourceManager::getInstance().getRegion("mainmenu_about_btn"), {1423.f, 60.f}, true)
 {
     createUI();
     createEffects();
@@ -12,10 +12,11 @@ const float BOUNCE_DURATION = 0.1f;
 NewGame::NewGame(sf::RenderWindow& window):
     m_window(window),
     m_requestedState(GameStateType::NoChange),
-    m_backgroundSprite(ResourceManager::getInstance().getTexture("newgame_background")),
-    m_pvpBtn(ResourceManager::getInstance().getTexture("newgame_pvp_btn"), {616.f, 450.f}, true),
-    m_pvbotBtn(ResourceManager::getInstance().getTexture("newgame_pvbot_btn"), {984.f, 450.f}, true),
-    m_backBtn(ResourceManager::getInstance().getTexture("newgame_back_btn"), {62.f, 57.f}, true),
+    m_backgroundTexture(ResourceManager::getInstance().acquireTexture("newgame_background")),
+    m_backgroundSprite(m_backgroundTexture.get()),
+    m_pvpBtn(ResourceManager::getInstance().getRegion("newgame_pvp_btn"), {616.f, 450.f}, true),
+    m_pvbotBtn(ResourceManager::getInstance().getRegion("newgame_pvbot_btn"), {984.f, 450.f}, true),
+    m_backBtn(ResourceManager::getInstance().getRegion("newgame_back_btn"), {62.f, 57.f}, true),
     m_selectedMode(GameMode::PlayerVsPlayer)
 {
     createUI();
@@ -11,13 +11,14 @@ const float BOUNCE_DURATION = 0.1f;
 PauseMenu::PauseMenu(sf::RenderWindow& window) :
     m_window(window),
     m_requestedState(GameStateType::NoChange),
-    m_backgroundSprite(ResourceManager::getInstance().getTexture("pause_background")),
-
-    m_resumeBtn(ResourceManager::getInstance().getTexture("pause_resume_btn"),       {476.f, 450.f}, true),
-    m_resetBtn(ResourceManager::getInstance().getTexture("pause_reset_btn"),         {800.f, 450.f}, true),
-    m_saveGameBtn(ResourceManager::getInstance().getTexture("pause_savegame_btn"),  {962.f, 450.f}, true),
-    m_settingsBtn(ResourceManager::getInstance().getTexture("pause_setting_btn"),    {638.f, 450.f}, true),
-    m_quitToMenuBtn(ResourceManager::getInstance().getTexture("pause_returnmenu_btn"),{1124.f, 450.f}, true)
+    m_backgroundTexture(ResourceManager::getInstance().acquireTexture("pause_background")),
+    m_backgroundSprite(m_backgroundTexture.get()),
+
+    m_resumeBtn(ResourceManager::getInstance().getRegion("pause_resume_btn"),       {476.f, 450.f}, true),
+    m_resetBtn(ResourceManager::getInstance().getRegion("pause_reset_btn"),         {800.f, 450.f}, true),
+    m_saveGameBtn(ResourceManager::getInstance().getRegion("pause_savegame_btn"),  {962.f, 450.f}, true),
+    m_settingsBtn(ResourceManager::getInstance().getRegion("pause_setting_btn"),    {638.f, 450.f}, true),
+    m_quitToMenuBtn(ResourceManager::getInstance().getRegion("pause_returnmenu_btn"),{1124.f, 450.f}, true)
 {
     sf::FloatRect bgBounds = m_backgroundSprite.getLocalBounds();
     m_backgroundSprite.setOrigin(bgBounds.width / 2.f, bgBounds.height / 2.f);
@@ -17,15 +17,16 @@ std::vector<std::string> splitStr(const std::string& s, char delimiter)
 SavedGame::SavedGame(sf::RenderWindow& window) :
     m_window(window),
     m_requestedState(GameStateType::NoChange),
-    m_background(ResourceManager::getInstance().getTexture("savedgame_background")),
-    m_backBtn(ResourceManager::getInstance().getTexture("savedgame_back_btn"), {100.f, 50.f}, true),
+    m_backgroundTexture(ResourceManager::getInstance().acquireTexture("savedgame_background")),
+    m_background(m_backgroundTexture.get()),
+    m_backBtn(ResourceManager::getInstance().getRegion("savedgame_back_btn"), {100.f, 50.f}, true),
     m_scrollOffset(0.f),
     m_maxScroll(0.f),
     m_slotHeight(180.f),
     m_showPopup(false),
     m_targetDeleteIndex(-1),
-    m_popupYesBtn(ResourceManager::getInstance().getTexture("savedgame_popupyes_btn"), {700.f, 500.f}, true),
-    m_popupNoBtn(ResourceManager::getInstance().getTexture("savedgame_popupno_btn"), {900.f, 500.f}, true)
+    m_popupYesBtn(ResourceManager::getInstance().getRegion("savedgame_popupyes_btn"), {700.f, 500.f}, true),
+    m_popupNoBtn(ResourceManager::getInstance().getRegion("savedgame_popupno_btn"), {900.f, 500.f}, true)
 {
     m_backBtn.setOnClick([this]()
     {
@@ -203,7 +204,7 @@ void SavedGame::createSlotUI(int index, const SaveInfo& info, float yPos)
     slot->textStatus.setPosition(470.f, std::round(yPos + 85.f));
 
     slot->btnLoad = std::make_unique<UI::Button>(
-        ResourceManager::getInstance().getTexture("savedgame_load_btn"),
+        ResourceManager::getInstance().getRegion("savedgame_load_btn"),
         sf::Vector2f{1150.f, std::round(yPos + 80.f)}, true
     );
     slot->btnLoad->setOnClick([this, index]()
@@ -212,7 +213,7 @@ void SavedGame::createSlotUI(int index, const SaveInfo& info, float yPos)
     });
 
     slot->btnDelete = std::make_unique<UI::Button>(
-        ResourceManager::getInstance().getTexture("savedgame_delete_btn"),
+        ResourceManager::getInstance().getRegion("savedgame_delete_btn"),
         sf::Vector2f{1250.f, std::round(yPos + 80.f)}, true
     );
     slot->btnDelete->setOnClick([this, index]()
@@ -37,7 +37,7 @@ ScoringOverlay::ScoringOverlay(int boardSize, float cellSize, sf::Vector2f board
     auto& gs = GlobalSetting::getInstance();
     auto& rm = ResourceManager::getInstance();
 
-    m_boardSprite.setTexture(rm.getTexture("scoreboard"));
+    rm.getRegion("scoreboard").applyTo(m_boardSprite);
     sf::FloatRect b = m_boardSprite.getLocalBounds();
     m_boardSprite.setOrigin(b.width / 2.f, b.height / 2.f);
     m_boardSprite.setColor(sf::Color(255, 255, 255, 0));
@@ -47,8 +47,8 @@ ScoringOverlay::ScoringOverlay(int boardSize, float cellSize, sf::Vector2f board
     std::string blackKey = gs.getStoneTextureKey(true, 13);
     std::string whiteKey = gs.getStoneTextureKey(false, 13);
 
-    m_iconBlackStone.setTexture(rm.getTexture(blackKey));
-    m_iconWhiteStone.setTexture(rm.getTexture(whiteKey));
+    rm.getRegion(blackKey).applyTo(m_iconBlackStone);
+    rm.getRegion(whiteKey).applyTo(m_iconWhiteStone);
 
     sf::FloatRect bounds = m_iconBlackStone.getLocalBounds();
     m_iconBlackStone.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
@@ -94,11 +94,11 @@ void ScoringOverlay::setScoreData(const ScoreData& data)
 
     if(totalB > totalW)
     {
-        m_stampSprite.setTexture(rm.getTexture("stamp_black_wins"));
+        rm.getRegion("stamp_black_wins").applyTo(m_stampSprite);
     }
     else
     {
-        m_stampSprite.setTexture(rm.getTexture("stamp_white_wins"));
+        rm.getRegion("stamp_white_wins").applyTo(m_stampSprite);
     }
 
     sf::FloatRect sb = m_stampSprite.getLocalBounds();
@@ -118,7 +118,7 @@ void ScoringOverlay::showSimpleResult(const std::string& message, bool blackWon)
     m_isSimpleMode = true;
 
     auto& rm = ResourceManager::getInstance();
-    m_boardSprite.setTexture(rm.getTexture("game_result_board"), true);
+    rm.getRegion("game_result_board").applyTo(m_boardSprite);
 
     sf::FloatRect b = m_boardSprite.getLocalBounds();
     m_boardSprite.setOrigin(b.width / 2.f, b.height / 2.f);
@@ -132,8 +132,8 @@ void ScoringOverlay::showSimpleResult(const std::string& message, bool blackWon)
     sf::FloatRect tb = m_simpleResultText.getLocalBounds();
     m_simpleResultText.setOrigin(tb.left + tb.width / 2.f, tb.top + tb.height / 2.f);
 
-    if(blackWon) m_stampSprite.setTexture(rm.getTexture("stamp_black_wins"));
-    else m_stampSprite.setTexture(rm.getTexture("stamp_white_wins"));
+    if(blackWon) rm.getRegion("stamp_black_wins").applyTo(m_stampSprite);
+    else rm.getRegion("stamp_white_wins").applyTo(m_stampSprite);
 
     sf::FloatRect sb = m_stampSprite.getLocalBounds();
     m_stampSprite.setOrigin(sb.width / 2.f, sb.height / 2.f);
@@ -499,7 +499,7 @@ void ScoringOverlay::startAnimation(const std::vector<TerritoryRegion>& regions,
         for(auto &p : r.points) if(!visited[p.y][p.x])
         {
             std::deque <sf::Vector2i> que; que.clear();
-            que.push_back(p);
+            que.push_back(sf::Vector2i(p.x, p.y));
 
             while(!que.empty())
             {
@@ -749,15 +749,15 @@ void ScoringOverlay::renderDeadStones(sf::RenderTarget& target)
         scale = FINAL_SCALE;
     }
 
-    const sf::Texture& blackTex = ResourceManager::getInstance().getTexture(GlobalSetting::getInstance().getStoneTextureKey(true, m_boardSize));
-    const sf::Texture& whiteTex = ResourceManager::getInstance().getTexture(GlobalSetting::getInstance().getStoneTextureKey(false, m_boardSize));
+    const TextureRegion& blackRegion = ResourceManager::getInstance().getRegion(GlobalSetting::getInstance().getStoneTextureKey(true, m_boardSize));
+    const TextureRegion& whiteRegion = ResourceManager::getInstance().getRegion(GlobalSetting::getInstance().getStoneTextureKey(false, m_boardSize));
 
     sf::Uint8 finalAlphaUint = static_cast<sf::Uint8>(alpha);
 
     for(const auto& stone : m_deadStones)
     {
         sf::Sprite s;
-        s.setTexture(stone.owner == TerritoryOwner::Black ? blackTex : whiteTex);
+        (stone.owner == TerritoryOwner::Black ? blackRegion : whiteRegion).applyTo(s);
 
         float px = m_boardTopLeft.x + stone.pos.x * m_cellSize;
         float py = m_boardTopLeft.y + stone.pos.y * m_cellSize;
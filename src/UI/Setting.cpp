@@ -10,9 +10,10 @@ Setting::Setting(sf::RenderWindow& window, GameStateType backState) :
     m_window(window),
     m_requestedState(GameStateType::NoChange),
     m_backState(backState),
-    m_backgroundSprite(ResourceManager::getInstance().getTexture("setting_background")),
-    m_applyBtn(ResourceManager::getInstance().getTexture("setting_apply_btn"), {942.f, 596.f}, true),
-    m_backBtn(ResourceManager::getInstance().getTexture("setting_back_btn"), {1057.f, 596.f}, true)
+    m_backgroundTexture(ResourceManager::getInstance().acquireTexture("setting_background")),
+    m_backgroundSprite(m_backgroundTexture.get()),
+    m_applyBtn(ResourceManager::getInstance().getRegion("setting_apply_btn"), {942.f, 596.f}, true),
+    m_backBtn(ResourceManager::getInstance().getRegion("setting_back_btn"), {1057.f, 596.f}, true)
 {
     createUI();
     loadSetting();
@@ -22,26 +22,27 @@ const sf::Color COLOR_UNSELECTED = sf::Color(120, 120, 120);
 SizeSelection::SizeSelection(sf::RenderWindow& window, GameMode mode, sf::Vector2f mousePos) :
     m_window(window),
     m_requestedState(GameStateType::NoChange),
-    m_background(ResourceManager::getInstance().getTexture("sizeselection_background")),
+    m_backgroundTexture(ResourceManager::getInstance().acquireTexture("sizeselection_background")),
+    m_background(m_backgroundTexture.get()),
     m_currentMode(mode),
     m_selectedSize(19),
     m_selectedDiff(AiDifficulty::Easy),
 
     m_startClickPos(mousePos),
 
-    m_9x9Btn(ResourceManager::getInstance().getTexture("sizeselection_9x9_btn"),     {396.f, 244.f}, true),
-    m_13x13Btn(ResourceManager::getInstance().getTexture("sizeselection_13x13_btn"), {800.f, 244.f}, true),
-    m_19x19Btn(ResourceManager::getInstance().getTexture("sizeselection_19x19_btn"), {1190.f, 244.f}, true),
+    m_9x9Btn(ResourceManager::getInstance().getRegion("sizeselection_9x9_btn"),     {396.f, 244.f}, true),
+    m_13x13Btn(ResourceManager::getInstance().getRegion("sizeselection_13x13_btn"), {800.f, 244.f}, true),
+    m_19x19Btn(ResourceManager::getInstance().getRegion("sizeselection_19x19_btn"), {1190.f, 244.f}, true),
 
-    m_easyBtn(ResourceManager::getInstance().getTexture("sizeselection_novice_btn"),   {491.f, 545.f}, true),
-    m_medBtn(ResourceManager::getInstance().getTexture("sizeselection_adept_btn"),     {800.f, 545.f}, true),
-    m_hardBtn(ResourceManager::getInstance().getTexture("sizeselection_master_btn"),   {1109.f, 545.f}, true),
+    m_easyBtn(ResourceManager::getInstance().getRegion("sizeselection_novice_btn"),   {491.f, 545.f}, true),
+    m_medBtn(ResourceManager::getInstance().getRegion("sizeselection_adept_btn"),     {800.f, 545.f}, true),
+    m_hardBtn(ResourceManager::getInstance().getRegion("sizeselection_master_btn"),   {1109.f, 545.f}, true),
 
-    m_playBtn(ResourceManager::getInstance().getTexture("sizeselection_apply_btn"),  {800.f, 810.f}, true),
-    m_backBtn(ResourceManager::getInstance().getTexture("sizeselection_back_btn"),    {62.f, 62.f}, true),
+    m_playBtn(ResourceManager::getInstance().getRegion("sizeselection_apply_btn"),  {800.f, 810.f}, true),
+    m_backBtn(ResourceManager::getInstance().getRegion("sizeselection_back_btn"),    {62.f, 62.f}, true),
 
-    m_sizeTextBg(ResourceManager::getInstance().getTexture("sizeselection_text_background")),
-    m_diffTextBg(ResourceManager::getInstance().getTexture("sizeselection_text_background"))
+    m_sizeTextBg(ResourceManager::getInstance().getRegion("sizeselection_text_background").makeSprite()),
+    m_diffTextBg(ResourceManager::getInstance().getRegion("sizeselection_text_background").makeSprite())
 {
     sf::FloatRect bounds = m_sizeTextBg.getLocalBounds();
     m_sizeTextBg.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
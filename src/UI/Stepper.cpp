@@ -12,8 +12,8 @@ Stepper::Stepper(sf::Vector2f minusBtnPos,
     m_options(options),
     m_currentIndex(defaultIndex),
     onChange(nullptr),
-    m_prevBtn(ResourceManager::getInstance().getTexture("stepper_minus_btn"), {0,0}, true),
-    m_nextBtn(ResourceManager::getInstance().getTexture("stepper_plus_btn"), {0,0}, true)
+    m_prevBtn(ResourceManager::getInstance().getRegion("stepper_minus_btn"), {0,0}, true),
+    m_nextBtn(ResourceManager::getInstance().getRegion("stepper_plus_btn"), {0,0}, true)
 {
     m_font = ResourceManager::getInstance().getFont("main_font");
 
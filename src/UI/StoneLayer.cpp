@@ -0,0 +1,185 @@
+// src/UI/StoneLayer.cpp
+#include "StoneLayer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace UI
+{
+
+const int ATLAS_PADDING = 2; // khoảng trống giữa các ô atlas riêng, tránh lem màu khi lọc mịn
+
+StoneLayer::StoneLayer() :
+    m_blackRegion(nullptr),
+    m_whiteRegion(nullptr),
+    m_texture(nullptr),
+    m_boardSize(0),
+    m_topLeft(0.f, 0.f),
+    m_spacing(0.f),
+    m_dirty(true),
+    m_vertices(sf::Triangles)
+{
+}
+
+void StoneLayer::setTextures(const TextureRegion& black, const TextureRegion& white)
+{
+    if(m_blackRegion == &black && m_whiteRegion == &white) return;
+
+    m_blackRegion = &black;
+    m_whiteRegion = &white;
+    m_dirty = true;
+
+    const TextureRegion& solid = ResourceManager::getInstance().getSolidRegion();
+    if(black.texture == white.texture && solid.texture == black.texture)
+    {
+        m_texture = black.texture;
+        m_blackRect = sf::FloatRect(black.rect);
+        m_whiteRect = sf::FloatRect(white.rect);
+        // Lấy phần giữa ô đặc để lọc mịn không chạm tới vùng xung quanh
+        m_solidRect = sf::FloatRect(solid.rect.left + 1.f, solid.rect.top + 1.f, solid.rect.width - 2.f, solid.rect.height - 2.f);
+        return;
+    }
+
+    buildOwnAtlas(black, white, solid);
+}
+
+void StoneLayer::buildOwnAtlas(const TextureRegion& black, const TextureRegion& white, const TextureRegion& solid)
+{
+    m_texture = nullptr;
+
+    // [pad][đen][pad][trắng][pad][ô đặc][pad]
+    unsigned int width = black.rect.width + white.rect.width + solid.rect.width + ATLAS_PADDING * 4;
+    unsigned int height = std::max({black.rect.height, white.rect.height, solid.rect.height}) + ATLAS_PADDING * 2;
+    if(!m_ownAtlas.create(width, height)) return;
+
+    m_ownAtlas.clear(sf::Color::Transparent);
+
+    // BlendNone: chép nguyên điểm ảnh, trộn alpha với nền trong suốt sẽ làm viền quân bị tối
+    sf::RenderStates copyStates(sf::BlendNone);
+
+    float blackX = (float)ATLAS_PADDING;
+    float whiteX = blackX + black.rect.width + ATLAS_PADDING;
+    float solidX = whiteX + white.rect.width + ATLAS_PADDING;
+    float top = (float)ATLAS_PADDING;
+
+    sf::Sprite sprite;
+    black.applyTo(sprite);
+    sprite.setPosition(blackX, top);
+    m_ownAtlas.draw(sprite, copyStates);
+
+    white.applyTo(sprite);
+    sprite.setPosition(whiteX, top);
+    m_ownAtlas.draw(sprite, copyStates);
+
+    solid.applyTo(sprite);
+    sprite.setPosition(solidX, top);
+    m_ownAtlas.draw(sprite, copyStates);
+
+    m_ownAtlas.display();
+    m_ownAtlas.setSmooth(black.texture->isSmooth());
+    m_texture = &m_ownAtlas.getTexture();
+
+    m_blackRect = sf::FloatRect(blackX, top, (float)black.rect.width, (float)black.rect.height);
+    m_whiteRect = sf::FloatRect(whiteX, top, (float)white.rect.width, (float)white.rect.height);
+    m_solidRect = sf::FloatRect(solidX + 1.f, top + 1.f, solid.rect.width - 2.f, solid.rect.height - 2.f);
+}
+
+void StoneLayer::setLayout(int boardSize, float left, float top, float spacing)
+{
+    if(boardSize != m_boardSize)
+    {
+        m_boardSize = boardSize;
+        m_cells.assign(boardSize * boardSize, Cell());
+        m_dirty = true;
+    }
+
+    if(left != m_topLeft.x || top != m_topLeft.y || spacing != m_spacing)
+    {
+        m_topLeft = sf::Vector2f(left, top);
+        m_spacing = spacing;
+        m_dirty = true;
+    }
+}
+
+void StoneLayer::setStone(int x, int y, StoneType stone, float scale, sf::Uint8 alpha)
+{
+    if(x < 0 || y < 0 || x >= m_boardSize || y >= m_boardSize) return;
+
+    // Ô trống không phụ thuộc scale/alpha, tránh dựng lại vô ích khi hiệu ứng còn chạy trên ô vừa bị bắt
+    Cell& cell = m_cells[y * m_boardSize + x];
+    cell.stone = stone;
+    cell.scale = (stone == StoneType::Empty) ? 1.f : scale;
+    cell.alpha = (stone == StoneType::Empty) ? 255 : alpha;
+}
+
+void StoneLayer::setLastMoveMarker(int x, int y, float size, sf::Color color)
+{
+    m_marker.x = x;
+    m_marker.y = y;
+    m_marker.size = size;
+    m_marker.color = color;
+}
+
+void StoneLayer::appendQuad(sf::Vector2f center, sf::Vector2f halfSize, const sf::FloatRect& texRect, sf::Color color)
+{
+    float left = center.x - halfSize.x;
+    float right = center.x + halfSize.x;
+    float top = center.y - halfSize.y;
+    float bottom = center.y + halfSize.y;
+
+    float texLeft = texRect.left;
+    float texRight = texRect.left + texRect.width;
+    float texTop = texRect.top;
+    float texBottom = texRect.top + texRect.height;
+
+    m_vertices.append(sf::Vertex(sf::Vector2f(left, top), color, sf::Vector2f(texLeft, texTop)));
+    m_vertices.append(sf::Vertex(sf::Vector2f(right, top), color, sf::Vector2f(texRight, texTop)));
+    m_vertices.append(sf::Vertex(sf::Vector2f(right, bottom), color, sf::Vector2f(texRight, texBottom)));
+
+    m_vertices.append(sf::Vertex(sf::Vector2f(left, top), color, sf::Vector2f(texLeft, texTop)));
+    m_vertices.append(sf::Vertex(sf::Vector2f(right, bottom), color, sf::Vector2f(texRight, texBottom)));
+    m_vertices.append(sf::Vertex(sf::Vector2f(left, bottom), color, sf::Vector2f(texLeft, texBottom)));
+}
+
+void StoneLayer::rebuildIfNeeded()
+{
+    if(!m_dirty && m_cells == m_builtCells && m_marker == m_builtMarker) return;
+
+    m_vertices.clear();
+    if(m_texture)
+    {
+        for(int y = 0; y < m_boardSize; ++y)
+        {
+            for(int x = 0; x < m_boardSize; ++x)
+            {
+                const Cell& cell = m_cells[y * m_boardSize + x];
+                if(cell.stone == StoneType::Empty) continue;
+
+                // Làm tròn tâm như khi vẽ bằng Sprite để quân không bị nhòe nửa điểm ảnh
+                sf::Vector2f center(std::round(m_topLeft.x + x * m_spacing), std::round(m_topLeft.y + y * m_spacing));
+                const sf::FloatRect& rect = (cell.stone == StoneType::Black) ? m_blackRect : m_whiteRect;
+                sf::Vector2f halfSize(rect.width / 2.f * cell.scale, rect.height / 2.f * cell.scale);
+                appendQuad(center, halfSize, rect, sf::Color(255, 255, 255, cell.alpha));
+
+                if(x == m_marker.x && y == m_marker.y)
+                {
+                    float half = m_marker.size / 2.f * cell.scale;
+                    appendQuad(center, sf::Vector2f(half, half), m_solidRect, m_marker.color);
+                }
+            }
+        }
+    }
+
+    m_builtCells = m_cells;
+    m_builtMarker = m_marker;
+    m_dirty = false;
+}
+
+void StoneLayer::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    if(m_vertices.getVertexCount() == 0 || !m_texture) return;
+
+    states.texture = m_texture;
+    target.draw(m_vertices, states);
+}
+
+}
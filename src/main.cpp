@@ -43,173 +43,176 @@ void loadAllResources()
  * USER INTERFACE RESOURCES LOADING
 **/
 
+    // Tham số false: ảnh dùng nguyên texture qua getTexture (thanh trượt, nền lặp...), giữ texture riêng thay vì gộp atlas
+    // Nền màn hình và bàn cờ dùng registerTexture: chỉ nạp khi màn hình cần (acquireTexture), thả khi đóng màn hình
+
 
 
     // --- ABOUT RESOURCES ---
-    rm.loadTexture("about_back_btn",     "resources/images/GoBackBtn_55x55_curve.png"); // Nút Back
-    rm.loadTexture("about_slider_track", "resources/images/About_slidetrack.png"); // Thanh trượt (About)
+    rm.queueTexture("about_back_btn",     "resources/images/GoBackBtn_55x55_curve.png"); // Nút Back
+    rm.queueTexture("about_slider_track", "resources/images/About_slidetrack.png", false); // Thanh trượt (About)
 
 
 
 
     // --- GAMEPLAY RESOURCES ---
-    rm.loadTexture("gameplay_background", "resources/images/GamePlayBackground_01.png");   // Nền màn hình chơi
+    rm.registerTexture("gameplay_background", "resources/images/GamePlayBackground_01.png");   // Nền màn hình chơi
 
     // --- board theme 0: basic
-    rm.loadTexture("gameplay_board_9x9_basic",  "resources/images/Board_9x9_740x740_bevel.png");   // Ảnh bàn cờ
-    rm.loadTexture("gameplay_board_13x13_basic",  "resources/images/board_13x13_740x740_bevel.png");   // Ảnh bàn cờ
-    rm.loadTexture("gameplay_board_19x19_basic",  "resources/images/board_19x19_740x740_bevel.png");   // Ảnh bàn cờ
+    rm.registerTexture("gameplay_board_9x9_basic",  "resources/images/Board_9x9_740x740_bevel.png");   // Ảnh bàn cờ
+    rm.registerTexture("gameplay_board_13x13_basic",  "resources/images/board_13x13_740x740_bevel.png");   // Ảnh bàn cờ
+    rm.registerTexture("gameplay_board_19x19_basic",  "resources/images/board_19x19_740x740_bevel.png");   // Ảnh bàn cờ
 
     // --- board theme 1: dark (gray)
-    rm.loadTexture("gameplay_board_9x9_dark",  "resources/images/board_9x9_theme1.png");   // Ảnh bàn cờ
-    rm.loadTexture("gameplay_board_13x13_dark",  "resources/images/board_13x13_theme1.png");   // Ảnh bàn cờ
-    rm.loadTexture("gameplay_board_19x19_dark",  "resources/images/board_19x19_theme1.png");   // Ảnh bàn cờ
+    rm.registerTexture("gameplay_board_9x9_dark",  "resources/images/board_9x9_theme1.png");   // Ảnh bàn cờ
+    rm.registerTexture("gameplay_board_13x13_dark",  "resources/images/board_13x13_theme1.png");   // Ảnh bàn cờ
+    rm.registerTexture("gameplay_board_19x19_dark",  "resources/images/board_19x19_theme1.png");   // Ảnh bàn cờ
 
     // --- board theme 2: light (blue pastel)
-    rm.loadTexture("gameplay_board_9x9_light",  "resources/images/board_9x9_theme2.png");   // Ảnh bàn cờ
-    rm.loadTexture("gameplay_board_13x13_light",  "resources/images/board_13x13_theme2.png");   // Ảnh bàn cờ
-    rm.loadTexture("gameplay_board_19x19_light",  "resources/images/board_19x19_theme2.png");   // Ảnh bàn cờ
+    rm.registerTexture("gameplay_board_9x9_light",  "resources/images/board_9x9_theme2.png");   // Ảnh bàn cờ
+    rm.registerTexture("gameplay_board_13x13_light",  "resources/images/board_13x13_theme2.png");   // Ảnh bàn cờ
+    rm.registerTexture("gameplay_board_19x19_light",  "resources/images/board_19x19_theme2.png");   // Ảnh bàn cờ
 
 
 
 
     // --- stone theme 0: basic
-    rm.loadTexture("gameplay_stone_black_9x9_basic","resources/images/blackStone_50x50.png");   // Quân cờ Đen
-    rm.loadTexture("gameplay_stone_white_9x9_basic","resources/images/whiteStone_50x50.png");   // Quân cờ Trắng
-    rm.loadTexture("gameplay_stone_black_13x13_basic","resources/images/blackStone_38x38.png");   // Quân cờ Đen
-    rm.loadTexture("gameplay_stone_white_13x13_basic","resources/images/whiteStone_38x38.png");   // Quân cờ Trắng
-    rm.loadTexture("gameplay_stone_black_19x19_basic","resources/images/blackStone_30x30.png");   // Quân cờ Đen
-    rm.loadTexture("gameplay_stone_white_19x19_basic","resources/images/whiteStone_30x30.png");   // Quân cờ Trắng
+    rm.queueTexture("gameplay_stone_black_9x9_basic","resources/images/blackStone_50x50.png");   // Quân cờ Đen
+    rm.queueTexture("gameplay_stone_white_9x9_basic","resources/images/whiteStone_50x50.png");   // Quân cờ Trắng
+    rm.queueTexture("gameplay_stone_black_13x13_basic","resources/images/blackStone_38x38.png");   // Quân cờ Đen
+    rm.queueTexture("gameplay_stone_white_13x13_basic","resources/images/whiteStone_38x38.png");   // Quân cờ Trắng
+    rm.queueTexture("gameplay_stone_black_19x19_basic","resources/images/blackStone_30x30.png");   // Quân cờ Đen
+    rm.queueTexture("gameplay_stone_white_19x19_basic","resources/images/whiteStone_30x30.png");   // Quân cờ Trắng
 
     // --- stone theme 1: cartoon
-    rm.loadTexture("gameplay_stone_black_9x9_cartoon","resources/images/Stone_quagmire_50x50.png");   // Quân cờ Đen
-    rm.loadTexture("gameplay_stone_white_9x9_cartoon","resources/images/Stone_Peter_50x50.png");   // Quân cờ Trắng
-    rm.loadTexture("gameplay_stone_black_13x13_cartoon","resources/images/Stone_quagmire_38x38.png");   // Quân cờ Đen
-    rm.loadTexture("gameplay_stone_white_13x13_cartoon","resources/images/Stone_Peter_38x38.png");   // Quân cờ Trắng
-    rm.loadTexture("gameplay_stone_black_19x19_cartoon","resources/images/Stone_quagmire_30x30.png");   // Quân cờ Đen
-    rm.loadTexture("gameplay_stone_white_19x19_cartoon","resources/images/Stone_Peter_30x30.png");   // Quân cờ Trắng
+    rm.queueTexture("gameplay_stone_black_9x9_cartoon","resources/images/Stone_quagmire_50x50.png");   // Quân cờ Đen
+    rm.queueTexture("gameplay_stone_white_9x9_cartoon","resources/images/Stone_Peter_50x50.png");   // Quân cờ Trắng
+    rm.queueTexture("gameplay_stone_black_13x13_cartoon","resources/images/Stone_quagmire_38x38.png");   // Quân cờ Đen
+    rm.queueTexture("gameplay_stone_white_13x13_cartoon","resources/images/Stone_Peter_38x38.png");   // Quân cờ Trắng
+    rm.queueTexture("gameplay_stone_black_19x19_cartoon","resources/images/Stone_quagmire_30x30.png");   // Quân cờ Đen
+    rm.queueTexture("gameplay_stone_white_19x19_cartoon","resources/images/Stone_Peter_30x30.png");   // Quân cờ Trắng
 
 
     // --- stone theme 2: realistic
-    rm.loadTexture("gameplay_stone_black_9x9_realistic","resources/images/blackstone_theme3_50x50.png");   // Quân cờ Đen
-    rm.loadTexture("gameplay_stone_white_9x9_realistic","resources/images/whitestone_theme3_50x50.png");   // Quân cờ Trắng
-    rm.loadTexture("gameplay_stone_black_13x13_realistic","resources/images/blackstone_theme3_38x38.png");   // Quân cờ Đen
-    rm.loadTexture("gameplay_stone_white_13x13_realistic","resources/images/whitestone_theme3_38x38.png");   // Quân cờ Trắng
-    rm.loadTexture("gameplay_stone_black_19x19_realistic","resources/images/blackstone_theme3_30x30.png");   // Quân cờ Đen
-    rm.loadTexture("gameplay_stone_white_19x19_realistic","resources/images/whitestone_theme3_30x30.png");   // Quân cờ Trắng
+    rm.queueTexture("gameplay_stone_black_9x9_realistic","resources/images/blackstone_theme3_50x50.png");   // Quân cờ Đen
+    rm.queueTexture("gameplay_stone_white_9x9_realistic","resources/images/whitestone_theme3_50x50.png");   // Quân cờ Trắng
+    rm.queueTexture("gameplay_stone_black_13x13_realistic","resources/images/blackstone_theme3_38x38.png");   // Quân cờ Đen
+    rm.queueTexture("gameplay_stone_white_13x13_realistic","resources/images/whitestone_theme3_38x38.png");   // Quân cờ Trắng
+    rm.queueTexture("gameplay_stone_black_19x19_realistic","resources/images/blackstone_theme3_30x30.png");   // Quân cờ Đen
+    rm.queueTexture("gameplay_stone_white_19x19_realistic","resources/images/whitestone_theme3_30x30.png");   // Quân cờ Trắng
 
 
 
 
-    rm.loadTexture("gameplay_pause_btn",  "resources/images/PauseBtn_45x45.png");
-    rm.loadTexture("gameplay_pass_btn",   "resources/images/PassBtn_80x55.png");
-    rm.loadTexture("gameplay_undo_btn",   "resources/images/UndoBtn_80x55.png");
-    rm.loadTexture("gameplay_redo_btn",   "resources/images/RedoBtn_80x55.png");
-    rm.loadTexture("gameplay_resign_btn",   "resources/images/resignBtn_45x45.png");
-    rm.loadTexture("gameplay_hint_btn",   "resources/images/hintBtn_45x45.png");
-    rm.loadTexture("gameplay_turnaction_background", "resources/images/TurnAction_BackGround_360x96.png");   // Background cho nút Pass, Undo, Redo
-    rm.loadTexture("gameplay_log_background", "resources/images/gameplay_log_560x45.png");   // Background cho nút Pass, Undo, Redo
-    rm.loadTexture("loading_icon", "resources/images/loadIcon_45x45.png");
+    rm.queueTexture("gameplay_pause_btn",  "resources/images/PauseBtn_45x45.png");
+    rm.queueTexture("gameplay_pass_btn",   "resources/images/PassBtn_80x55.png");
+    rm.queueTexture("gameplay_undo_btn",   "resources/images/UndoBtn_80x55.png");
+    rm.queueTexture("gameplay_redo_btn",   "resources/images/RedoBtn_80x55.png");
+    rm.queueTexture("gameplay_resign_btn",   "resources/images/resignBtn_45x45.png");
+    rm.queueTexture("gameplay_hint_btn",   "resources/images/hintBtn_45x45.png");
+    rm.queueTexture("gameplay_turnaction_background", "resources/images/TurnAction_BackGround_360x96.png");   // Background cho nút Pass, Undo, Redo
+    rm.queueTexture("gameplay_log_background", "resources/images/gameplay_log_560x45.png");   // Background cho nút Pass, Undo, Redo
+    rm.queueTexture("loading_icon", "resources/images/loadIcon_45x45.png");
 
-    rm.loadTexture("gameplay_historylist_background",      "resources/images/HistoryList_background.png");    // Nền History List
-    rm.loadTexture("gameplay_historylist_track",  "resources/images/historyboard_slidertrack.png");    // Thanh trượt của HistoryList
-    rm.loadTexture("gameplay_historylist_icon_black","resources/images/blackStone_38x38.png");  // Icon quân đen (cho list)
-    rm.loadTexture("gameplay_historylist_icon_white","resources/images/whiteStone_38x38.png");  // Icon quân trắng (cho list)
-    rm.loadTexture("gameplay_timeline_background", "resources/images/timeline_background_1210x18.png");  // Nền Timeline
-    rm.loadTexture("gameplay_timeline_tooltip_bg","resources/images/TimeLine_tooltip_90x45_gray.png"); // Nền Tooltip
+    rm.queueTexture("gameplay_historylist_background",      "resources/images/HistoryList_background.png", false);    // Nền History List
+    rm.queueTexture("gameplay_historylist_track",  "resources/images/historyboard_slidertrack.png", false);    // Thanh trượt của HistoryList
+    rm.queueTexture("gameplay_historylist_icon_black","resources/images/blackStone_38x38.png");  // Icon quân đen (cho list)
+    rm.queueTexture("gameplay_historylist_icon_white","resources/images/whiteStone_38x38.png");  // Icon quân trắng (cho list)
+    rm.queueTexture("gameplay_timeline_background", "resources/images/timeline_background_1210x18.png", false);  // Nền Timeline
+    rm.queueTexture("gameplay_timeline_tooltip_bg","resources/images/TimeLine_tooltip_90x45_gray.png", false); // Nền Tooltip
 
-    rm.loadTexture("gameplay_timer_bg", "resources/images/timer_board_bg_250x145.png");
+    rm.queueTexture("gameplay_timer_bg", "resources/images/timer_board_bg_250x145.png");
 
 
 
     // --- MAINMENU RESOURCES ---
-    rm.loadTexture("mainmenu_background", "resources/images/MainMenuBackground.png");
-    rm.loadTexture("mainmenu_newgame_btn", "resources/images/NewGameBtn_190x190.png");
-    rm.loadTexture("mainmenu_savedgame_btn", "resources/images/SavedGameBtn_190x190.png");
-    rm.loadTexture("mainmenu_setting_btn", "resources/images/SettingBtn_190x190.png");
-    rm.loadTexture("mainmenu_about_btn", "resources/images/AboutBtn_80x80.png");
-    rm.loadTexture("mainmenu_quit_btn", "resources/images/ExitBtn_65x65.png");
+    rm.registerTexture("mainmenu_background", "resources/images/MainMenuBackground.png");
+    rm.queueTexture("mainmenu_newgame_btn", "resources/images/NewGameBtn_190x190.png");
+    rm.queueTexture("mainmenu_savedgame_btn", "resources/images/SavedGameBtn_190x190.png");
+    rm.queueTexture("mainmenu_setting_btn", "resources/images/SettingBtn_190x190.png");
+    rm.queueTexture("mainmenu_about_btn", "resources/images/AboutBtn_80x80.png");
+    rm.queueTexture("mainmenu_quit_btn", "resources/images/ExitBtn_65x65.png");
 
 
 
 
     // --- NEWGAME RESOURCES ---
-    rm.loadTexture("newgame_background", "resources/images/NewGameBackground.png");
-    rm.loadTexture("newgame_pvp_btn", "resources/images/pvpBtn_190x190.png");
-    rm.loadTexture("newgame_pvbot_btn", "resources/images/pvbotBtn_190x190.png");
-    rm.loadTexture("newgame_back_btn", "resources/images/GoBackBtn_55x55_curve.png");
+    rm.registerTexture("newgame_background", "resources/images/NewGameBackground.png");
+    rm.queueTexture("newgame_pvp_btn", "resources/images/pvpBtn_190x190.png");
+    rm.queueTexture("newgame_pvbot_btn", "resources/images/pvbotBtn_190x190.png");
+    rm.queueTexture("newgame_back_btn", "resources/images/GoBackBtn_55x55_curve.png");
 
 
 
 
     // --- PAUSE RESOURCES ---
-    rm.loadTexture("pause_background", "resources/images/pause_background.png");
-    rm.loadTexture("pause_resume_btn", "resources/images/ResumeBtn_120x83.png");
-    rm.loadTexture("pause_setting_btn", "resources/images/SettingBtn_120x83.png");
-    rm.loadTexture("pause_savegame_btn", "resources/images/SaveGameBtn_120x83.png");
-    rm.loadTexture("pause_reset_btn", "resources/images/resetBtn_120x83.png");
-    rm.loadTexture("pause_returnmenu_btn", "resources/images/MenuBtn_120x83.png");
+    rm.registerTexture("pause_background", "resources/images/pause_background.png");
+    rm.queueTexture("pause_resume_btn", "resources/images/ResumeBtn_120x83.png");
+    rm.queueTexture("pause_setting_btn", "resources/images/SettingBtn_120x83.png");
+    rm.queueTexture("pause_savegame_btn", "resources/images/SaveGameBtn_120x83.png");
+    rm.queueTexture("pause_reset_btn", "resources/images/resetBtn_120x83.png");
+    rm.queueTexture("pause_returnmenu_btn", "resources/images/MenuBtn_120x83.png");
 
 
 
 
     // --- SAVED GAME RESOURCES ---
-    rm.loadTexture("savedgame_background", "resources/images/SavedGameBackground.png");
-    rm.loadTexture("savedgame_back_btn", "resources/images/GoBackBtn_55x55_curve.png");
-//    /** **/ rm.loadTexture("savedgame_popup_background", "resources/images/");
-    rm.loadTexture("savedgame_popupyes_btn", "resources/images/savedgame_popupyes_117x80.png");
-    rm.loadTexture("savedgame_popupno_btn", "resources/images/savedgame_popupno_117x80.png");
-    rm.loadTexture("savedgame_slidertrack_btn", "resources/images/SavedGame_slidertrack.png");
-    rm.loadTexture("savedgame_delete_btn", "resources/images/savedgame_deleteBtn_50x50.png");
-    rm.loadTexture("savedgame_load_btn", "resources/images/savedgame_loadBtn_50x50.png");
+    rm.registerTexture("savedgame_background", "resources/images/SavedGameBackground.png");
+    rm.queueTexture("savedgame_back_btn", "resources/images/GoBackBtn_55x55_curve.png");
+//    /** **/ rm.queueTexture("savedgame_popup_background", "resources/images/");
+    rm.queueTexture("savedgame_popupyes_btn", "resources/images/savedgame_popupyes_117x80.png");
+    rm.queueTexture("savedgame_popupno_btn", "resources/images/savedgame_popupno_117x80.png");
+    rm.queueTexture("savedgame_slidertrack_btn", "resources/images/SavedGame_slidertrack.png", false);
+    rm.queueTexture("savedgame_delete_btn", "resources/images/savedgame_deleteBtn_50x50.png");
+    rm.queueTexture("savedgame_load_btn", "resources/images/savedgame_loadBtn_50x50.png");
 
 
 
 
     // --- SCORING OVERLAY RESOURCES ---
-    rm.loadTexture("territory_line", "resources/images/white_gradient_40x40.png");
-    rm.loadTexture("stamp_black_wins", "resources/images/stamp_blackwin_140x142.png");
-    rm.loadTexture("stamp_white_wins", "resources/images/stamp_whitewin_140x142.png");
-    rm.loadTexture("scoreboard", "resources/images/scoreboard_320x350.png");
-    rm.loadTexture("game_result_board", "resources/images/simple_endgame_background_320x105.png");
+    rm.queueTexture("territory_line", "resources/images/white_gradient_40x40.png", false);
+    rm.queueTexture("stamp_black_wins", "resources/images/stamp_blackwin_140x142.png");
+    rm.queueTexture("stamp_white_wins", "resources/images/stamp_whitewin_140x142.png");
+    rm.queueTexture("scoreboard", "resources/images/scoreboard_320x350.png");
+    rm.queueTexture("game_result_board", "resources/images/simple_endgame_background_320x105.png");
 
 
 
 
     // --- SETTING RESOURCES ---
-    rm.loadTexture("setting_background", "resources/images/settingBackground.png");
-    rm.loadTexture("setting_apply_btn", "resources/images/setting_applyBtn_58x40.png");
-    rm.loadTexture("setting_back_btn", "resources/images/setting_backBtn_58x40.png");
-    rm.loadTexture("setting_slidertrack_btn", "resources/images/setting_slidertrack_250x10.png");
+    rm.registerTexture("setting_background", "resources/images/settingBackground.png");
+    rm.queueTexture("setting_apply_btn", "resources/images/setting_applyBtn_58x40.png");
+    rm.queueTexture("setting_back_btn", "resources/images/setting_backBtn_58x40.png");
+    rm.queueTexture("setting_slidertrack_btn", "resources/images/setting_slidertrack_250x10.png", false);
 
 
 
 
     // --- SIZESELECTION RESOURCES ---
-    rm.loadTexture("sizeselection_background", "resources/images/SizeSelectionBackground.png");
-    rm.loadTexture("sizeselection_9x9_btn", "resources/images/SizeBtn_9x9_190x190.png");
-    rm.loadTexture("sizeselection_13x13_btn", "resources/images/SizeBtn_13x13_190x190.png");
-    rm.loadTexture("sizeselection_19x19_btn", "resources/images/SizeBtn_19x19_190x190.png");
-    rm.loadTexture("sizeselection_novice_btn", "resources/images/NoviceBtn_190x190.png");
-    rm.loadTexture("sizeselection_adept_btn", "resources/images/AdeptBtn_190x190.png");
-    rm.loadTexture("sizeselection_master_btn", "resources/images/MasterBtn_190x190.png");
-    rm.loadTexture("sizeselection_apply_btn", "resources/images/sizeselection_startBtn_120x120.png");
-    rm.loadTexture("sizeselection_back_btn", "resources/images/GoBackBtn_55x55_curve.png");
-    rm.loadTexture("sizeselection_text_background", "resources/images/sizeselection_text_background.png");
-//    rm.loadTexture("drum_drop", )
+    rm.registerTexture("sizeselection_background", "resources/images/SizeSelectionBackground.png");
+    rm.queueTexture("sizeselection_9x9_btn", "resources/images/SizeBtn_9x9_190x190.png");
+    rm.queueTexture("sizeselection_13x13_btn", "resources/images/SizeBtn_13x13_190x190.png");
+    rm.queueTexture("sizeselection_19x19_btn", "resources/images/SizeBtn_19x19_190x190.png");
+    rm.queueTexture("sizeselection_novice_btn", "resources/images/NoviceBtn_190x190.png");
+    rm.queueTexture("sizeselection_adept_btn", "resources/images/AdeptBtn_190x190.png");
+    rm.queueTexture("sizeselection_master_btn", "resources/images/MasterBtn_190x190.png");
+    rm.queueTexture("sizeselection_apply_btn", "resources/images/sizeselection_startBtn_120x120.png");
+    rm.queueTexture("sizeselection_back_btn", "resources/images/GoBackBtn_55x55_curve.png");
+    rm.queueTexture("sizeselection_text_background", "resources/images/sizeselection_text_background.png");
+//    rm.queueTexture("drum_drop", )
 
 
 
     // --- STEPPER RESOURCES ---
-    rm.loadTexture("stepper_minus_btn", "resources/images/MinusBtn_40x40.png");
-    rm.loadTexture("stepper_plus_btn", "resources/images/PlusBtn_40x40.png");
+    rm.queueTexture("stepper_minus_btn", "resources/images/MinusBtn_40x40.png");
+    rm.queueTexture("stepper_plus_btn", "resources/images/PlusBtn_40x40.png");
 
 
 
 
     // --- TIMELINE RESOURCES ---
-//    rm.loadTexture("timeline_background", "resources/images/");
-//    rm.loadTexture("timeline_tooltip_background", "resources/images/");
+//    rm.queueTexture("timeline_background", "resources/images/");
+//    rm.queueTexture("timeline_tooltip_background", "resources/images/");
 
 
 
@@ -220,42 +223,42 @@ void loadAllResources()
     // Các sfx cho theme quân cờ cơ bản
     // --- THEME 0: BASIC (Cơ bản) ---
     // Dù file âm thanh giống nhau, ta vẫn đặt key riêng để Logic code thống nhất
-    rm.loadSoundBuffer("place_black_basic",       "resources/sounds/place_stone_01.wav");
-    rm.loadSoundBuffer("place_white_basic",       "resources/sounds/place_stone_01.wav");
-    rm.loadSoundBuffer("pass_black_basic",         "resources/sounds/pass_sound.wav");
-    rm.loadSoundBuffer("pass_white_basic",         "resources/sounds/pass_sound.wav");
+    rm.queueSoundBuffer("place_black_basic",       "resources/sounds/place_stone_01.wav");
+    rm.queueSoundBuffer("place_white_basic",       "resources/sounds/place_stone_01.wav");
+    rm.queueSoundBuffer("pass_black_basic",         "resources/sounds/pass_sound.wav");
+    rm.queueSoundBuffer("pass_white_basic",         "resources/sounds/pass_sound.wav");
 
     // Capture (Ăn quân)
-    rm.loadSoundBuffer("capture_black_basic",     "resources/sounds/capture_sound.wav");
-    rm.loadSoundBuffer("capture_white_basic",     "resources/sounds/capture_sound.wav");
+    rm.queueSoundBuffer("capture_black_basic",     "resources/sounds/capture_sound.wav");
+    rm.queueSoundBuffer("capture_white_basic",     "resources/sounds/capture_sound.wav");
 
     // Error (Nước đi lỗi)
-    rm.loadSoundBuffer("error_black_basic",       "resources/sounds/error_move_sound.wav");
-    rm.loadSoundBuffer("error_white_basic",       "resources/sounds/error_move_sound.wav");
+    rm.queueSoundBuffer("error_black_basic",       "resources/sounds/error_move_sound.wav");
+    rm.queueSoundBuffer("error_white_basic",       "resources/sounds/error_move_sound.wav");
 
 
     // --- THEME 1: CARTOON (Hoạt hình) ---
-    rm.loadSoundBuffer("place_black_cartoon",     "resources/sounds/place_stone_01.wav"); // Hoặc dùng chung basic
-    rm.loadSoundBuffer("place_white_cartoon",     "resources/sounds/place_stone_01.wav"); // Hoặc dùng chung basic
-    rm.loadSoundBuffer("pass_black_cartoon",       "resources/sounds/pass_sound.wav");
-    rm.loadSoundBuffer("pass_white_cartoon",       "resources/sounds/pass_sound.wav");
+    rm.queueSoundBuffer("place_black_cartoon",     "resources/sounds/place_stone_01.wav"); // Hoặc dùng chung basic
+    rm.queueSoundBuffer("place_white_cartoon",     "resources/sounds/place_stone_01.wav"); // Hoặc dùng chung basic
+    rm.queueSoundBuffer("pass_black_cartoon",       "resources/sounds/pass_sound.wav");
+    rm.queueSoundBuffer("pass_white_cartoon",       "resources/sounds/pass_sound.wav");
 
     // Capture - Riêng biệt
-    rm.loadSoundBuffer("capture_black_cartoon",   "resources/sounds/capture_sound_quagmire.wav"); // Quagmire: "All Right"
-    rm.loadSoundBuffer("capture_white_cartoon",   "resources/sounds/capture_sound_peter.wav"); // Peter: "Roadhouse"
+    rm.queueSoundBuffer("capture_black_cartoon",   "resources/sounds/capture_sound_quagmire.wav"); // Quagmire: "All Right"
+    rm.queueSoundBuffer("capture_white_cartoon",   "resources/sounds/capture_sound_peter.wav"); // Peter: "Roadhouse"
 
     // Error - Riêng biệt
-    rm.loadSoundBuffer("error_black_cartoon",     "resources/sounds/error_move_quagmire.wav");
-    rm.loadSoundBuffer("error_white_cartoon",     "resources/sounds/error_move_peter.wav");
+    rm.queueSoundBuffer("error_black_cartoon",     "resources/sounds/error_move_quagmire.wav");
+    rm.queueSoundBuffer("error_white_cartoon",     "resources/sounds/error_move_peter.wav");
 
 
 
     // Âm thanh khi tính điểm
-    rm.loadSoundBuffer("count_tick", "resources/sounds/Digital counting.wav");
-    rm.loadSoundBuffer("stamp_impact", "resources/sounds/stamp seal.wav");
+    rm.queueSoundBuffer("count_tick", "resources/sounds/Digital counting.wav");
+    rm.queueSoundBuffer("stamp_impact", "resources/sounds/stamp seal.wav");
 
 
-    rm.loadSoundBuffer("drum_drop", "resources/sounds/drum drop.wav");
+    rm.queueSoundBuffer("drum_drop", "resources/sounds/drum drop.wav");
 
 
 
@@ -270,7 +273,8 @@ void loadAllResources()
     rm.loadCursor("cursor_hand",  sf::Cursor::Hand);  // Con trỏ bàn tay (khi hover)
     rm.loadCursor("cursor_wait",  sf::Cursor::Wait);  // (Tùy chọn) Đồng hồ cát
 
-    std::cout << "Resources loaded successfully!" << std::endl;
+    // Giải mã ảnh/âm thanh trên các luồng phụ; LoadingScreen đưa lên GPU và dựng atlas khi xong
+    rm.startLoading();
 }
 
 int main()
@@ -284,11 +288,14 @@ int main()
     auto& rm = ResourceManager::getInstance();
     auto& gs = GlobalSetting::getInstance();
 
+    // resources.pak do assetpack tạo; không có thì đọc từng file trong resources/
+    rm.mountArchive("resources.pak");
+
     rm.setMusicVolume(gs.musicVolume);
 
     rm.playMusic(gs.musicThemeIndex);
 
-    BotManager::getInstance().startBackgroundPachi(19);
+    BotManager::getInstance().warmUpEngines(19);
 
     loadAllResources();
 